@@ -0,0 +1,355 @@
+// Host benchmark suite for the firmware's encode, decode and playback paths,
+// run against the Arduino shim's virtual clock. Results are printed as CSV
+// (default) or JSON so runs can be compared between firmware revisions.
+//
+//   pio run -e bench && .pio/build/bench/program [--json]
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "echo_cache.h"
+#include "morse_converter.h"
+#include "morse_decoder.h"
+#include "morse_echo.h"
+#include "preset_store.h"
+
+namespace {
+
+// Fixed corpus: a pangram repeated to each benchmark length
+const char CORPUS_SENTENCE[] = "The quick brown fox jumps over the lazy dog 1234567890. ";
+const size_t CORPUS_LENGTHS[] = {16, 64, 256, 1024, 4096};
+// Message played end to end under the simulated clock
+const char PLAYBACK_MESSAGE[] = "SOS PARIS 73";
+
+struct Result {
+    std::string name;
+    std::string param;
+    double value;
+    std::string unit;
+};
+
+std::vector<Result> results;
+
+std::string corpus(size_t length) {
+    std::string text;
+    while (text.size() < length) {
+        text += CORPUS_SENTENCE;
+    }
+    text.resize(length);
+    return text;
+}
+
+// Runs fn repeatedly for at least minSeconds and returns nanoseconds per call
+template <typename Fn>
+double nsPerCall(Fn fn, double minSeconds = 0.05) {
+    size_t calls = 0;
+    size_t batch = 1;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while (elapsed < minSeconds) {
+        for (size_t i = 0; i < batch; i++) {
+            fn();
+        }
+        calls += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return elapsed * 1e9 / calls;
+}
+
+void record(const char* name, const std::string& param, double value, const char* unit) {
+    results.push_back({name, param, value, unit});
+}
+
+volatile uintptr_t sink;
+
+void benchEncode() {
+    for (size_t length : CORPUS_LENGTHS) {
+        const std::string text = corpus(length);
+        const std::string param = "len=" + std::to_string(length);
+
+        // findMorseCode forwards to morseCodeFor
+        const double lookup = nsPerCall([&] {
+            uintptr_t sum = 0;
+            for (char c : text) {
+                sum += reinterpret_cast<uintptr_t>(morseCodeFor(c));
+            }
+            sink = sum;
+        });
+        record("find_morse_code", param, lookup / length, "ns/char");
+
+        // textToMorse's encoder, with a buffer large enough not to truncate
+        std::vector<char> out(morseEncodedLength(text.c_str()) + 1);
+        const double ascii = nsPerCall([&] { sink = encodeMorse(text.c_str(), out.data(), out.size()).length; });
+        record("text_to_morse", param, ascii / length, "ns/char");
+
+        MorseStreamEncoder encoder;
+        const double stream = nsPerCall([&] {
+            encoder.begin(text.c_str(), text.size());
+            MorseSymbol symbol;
+            size_t count = 0;
+            while (encoder.next(symbol)) {
+                count++;
+            }
+            sink = count;
+        });
+        record("stream_encode", param, stream / length, "ns/char");
+    }
+}
+
+void benchDecode() {
+    for (size_t length : CORPUS_LENGTHS) {
+        const std::string text = corpus(length);
+        std::vector<char> ascii(morseEncodedLength(text.c_str()) + 1);
+        encodeMorse(text.c_str(), ascii.data(), ascii.size());
+        std::vector<char> out(text.size() + 1);
+
+        MorseDecoder decoder;
+        const double decode = nsPerCall([&] { sink = decoder.decode(ascii.data(), out.data(), out.size()); });
+        record("decode_ascii", "len=" + std::to_string(length), decode / length, "ns/char");
+    }
+}
+
+// Echo notification size per format, for text that fits one Text Input write
+void benchEcho(MorseConverter& morse) {
+    const size_t lengths[] = {16, 64, 100};
+    uint8_t out[packedEchoSize(PackedMorse::CAPACITY)];
+    for (size_t length : lengths) {
+        const std::string text = corpus(length);
+        const std::string param = "len=" + std::to_string(length);
+        const PackedMorse& packed = morse.textToPackedMorse(text.c_str(), text.size());
+        const bool truncated = morse.wasTruncated();
+
+        record("echo_bytes_ascii", param, strlen(morse.packedToAscii(packed)), "bytes");
+        record("echo_bytes_packed", param, encodePackedEcho(packed, truncated, out, sizeof(out)), "bytes");
+        record("echo_bytes_digest", param, encodeDigestEcho(packed, truncated, out, sizeof(out)), "bytes");
+        record("echo_encode_packed", param,
+               nsPerCall([&] { sink = encodePackedEcho(packed, truncated, out, sizeof(out)); }), "ns");
+        record("echo_encode_digest", param,
+               nsPerCall([&] { sink = encodeDigestEcho(packed, truncated, out, sizeof(out)); }), "ns");
+    }
+}
+
+// Echo of a message sent again: encoded on a miss, replayed from the cache on a
+// hit, and the digest notice sent instead once the central has it
+void benchEchoCache(MorseConverter& morse) {
+    const size_t lengths[] = {16, 32, 64};
+    uint8_t out[packedEchoSize(PackedMorse::CAPACITY)];
+    for (size_t length : lengths) {
+        const std::string text = corpus(length);
+        const std::string param = "len=" + std::to_string(length);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+        EchoCache cache;
+
+        const double miss = nsPerCall([&] {
+            const uint32_t hash = echoCacheHash(data, length, MorseAlphabet::LATIN);
+            cache.clear();
+            cache.find(hash, data, length, MorseAlphabet::LATIN);
+            CachedEcho& cached = cache.claim(hash, data, length, MorseAlphabet::LATIN);
+            const PackedMorse& packed = morse.textToPackedMorse(text.c_str(), length);
+            cached.assign(packed);
+            cache.commit(cached, false);
+            sink = encodePackedEcho(packed, false, out, sizeof(out));
+        });
+        record("echo_cache_miss", param, miss, "ns");
+
+        const double hit = nsPerCall([&] {
+            const CachedEcho* cached = cache.find(echoCacheHash(data, length, MorseAlphabet::LATIN), data, length, MorseAlphabet::LATIN);
+            sink = encodePackedEcho(morse.loadPackedMorse(cached->packed, cached->symbolCount, false), false, out, sizeof(out));
+        });
+        record("echo_cache_hit", param, hit, "ns");
+
+        const CachedEcho* cached = cache.find(echoCacheHash(data, length, MorseAlphabet::LATIN), data, length, MorseAlphabet::LATIN);
+        record("echo_bytes_packed_cached", param, packedEchoSize(cached->symbolCount), "bytes");
+        record("echo_bytes_cached_notice", param,
+               encodeCachedEcho(true, false, cached->symbolCount, cached->crc, out, sizeof(out)), "bytes");
+    }
+}
+
+struct ChunkTiming {
+    std::chrono::steady_clock::time_point start;
+    double firstChunkNs;
+    size_t chunks;
+};
+
+bool timeChunk(const uint8_t*, size_t, void* context) {
+    ChunkTiming& timing = *static_cast<ChunkTiming*>(context);
+    if (timing.chunks++ == 0) {
+        timing.firstChunkNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - timing.start).count();
+    }
+    return true;
+}
+
+// Time to the first echo byte: whole-message ASCII echo vs streamed 180-byte chunks
+void benchEchoStream(MorseConverter& morse) {
+    const size_t lengths[] = {64, 256, 1024, 4096};
+    const size_t CHUNK = 180;
+    const int REPEATS = 200;
+    EchoStreamer streamer;
+    for (size_t length : lengths) {
+        const std::string text = corpus(length);
+        const std::string param = "len=" + std::to_string(length);
+
+        const double whole = nsPerCall([&] {
+            sink = reinterpret_cast<uintptr_t>(morse.packedToAscii(morse.textToPackedMorse(text.c_str(), text.size())));
+        });
+        record("echo_first_byte_whole", param, whole, "ns");
+
+        double firstChunk = 0;
+        size_t chunks = 0;
+        for (int i = 0; i < REPEATS; i++) {
+            ChunkTiming timing = {std::chrono::steady_clock::now(), 0, 0};
+            MorseStreamEncoder encoder;
+            encoder.begin(text.c_str(), text.size());
+            streamer.begin(EchoFormat::ASCII, CHUNK, timeChunk, &timing);
+            MorseSymbol symbol;
+            while (encoder.next(symbol)) {
+                streamer.add(symbol);
+            }
+            streamer.finish(false);
+            firstChunk += timing.firstChunkNs;
+            chunks = timing.chunks;
+        }
+        record("echo_first_byte_streamed", param, firstChunk / REPEATS, "ns");
+        record("echo_stream_chunks", param, chunks, "chunks");
+    }
+}
+
+void benchPlayback(MorseConverter& morse) {
+    halReset();
+    halSetTraceEnabled(false);
+
+    // Not playing: the early return
+    morse.stopPlayback();
+    record("update_playback_idle", "stopped", nsPerCall([&] { morse.updatePlayback(); }), "ns/call");
+
+    // Playing, but the current symbol's deadline has not passed
+    morse.startTextPlayback(PLAYBACK_MESSAGE, strlen(PLAYBACK_MESSAGE));
+    record("update_playback_idle", "mid_symbol", nsPerCall([&] { morse.updatePlayback(); }), "ns/call");
+
+    // Every call crosses a deadline and changes state
+    const double transition = nsPerCall([&] {
+        if (!morse.isPlaybackActive()) {
+            morse.startTextPlayback(PLAYBACK_MESSAGE, strlen(PLAYBACK_MESSAGE));
+        }
+        halAdvanceMillis(1000);
+        morse.updatePlayback();
+    });
+    record("update_playback_transition", "", transition, "ns/call");
+    morse.stopPlayback();
+
+    // Whole message at a 1 ms loop tick
+    halReset();
+    halSetTraceEnabled(false);
+    size_t calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    morse.startTextPlayback(PLAYBACK_MESSAGE, strlen(PLAYBACK_MESSAGE));
+    while (morse.isPlaybackActive()) {
+        halAdvanceMillis(1);
+        morse.updatePlayback();
+        calls++;
+    }
+    const double cpuUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    record("playback_message", "message_ms", halMicros() / 1000.0, "ms");
+    record("playback_message", "update_calls", calls, "calls");
+    record("playback_message", "cpu", cpuUs, "us");
+}
+
+// Virtual time from a text write (status indications as in handleTextInput, then
+// queueing) to the first LED pulse, with the playback loop ticking every 1 ms
+void benchWriteToFirstPulse(MorseConverter& morse) {
+    halReset();
+    const uint64_t writeUs = halMicros();
+    morse.indicateProcessing();
+    morse.indicatePlaying();
+    morse.queueText(reinterpret_cast<const uint8_t*>(PLAYBACK_MESSAGE), strlen(PLAYBACK_MESSAGE));
+
+    bool pulsed = false;
+    uint64_t firstPulseUs = 0;
+    for (int tick = 0; !pulsed && tick < 1000; tick++) {
+        morse.updatePlayback();
+        for (const HalEvent& event : halTrace()) {
+            if (event.type == HalEventType::DIGITAL_WRITE && event.pin == LED_PIN && event.value == LOW) {
+                firstPulseUs = event.timeUs;
+                pulsed = true;
+                break;
+            }
+        }
+        if (!pulsed) {
+            halAdvanceMillis(1);
+        }
+    }
+    morse.stopPlayback();
+    record("write_to_first_pulse", "", (firstPulseUs - writeUs) / 1000.0, "ms");
+}
+
+// Host time from queueing a message to its first edge: text is scanned for the
+// ETA and encoded as it plays, a preset's symbols are ready
+void benchPresetStart(MorseConverter& morse) {
+    const size_t lengths[] = {16, 64, 100};
+    static PresetStore presets;
+    halReset();
+    halSetTraceEnabled(false);
+    for (size_t length : lengths) {
+        const std::string text = corpus(length);
+        const std::string param = "len=" + std::to_string(length);
+        size_t slot = 0;
+        presets.store(1, morse.textToPackedMorse(text.c_str(), text.size()), slot);
+        const MorsePreset* preset = presets.find(1);
+
+        record("queue_to_first_edge_text", param, nsPerCall([&] {
+            morse.queueText(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+            morse.updatePlayback();
+            morse.stopPlayback();
+        }), "ns");
+        record("queue_to_first_edge_preset", param, nsPerCall([&] {
+            morse.queuePacked(preset->packed, preset->symbolCount);
+            morse.updatePlayback();
+            morse.stopPlayback();
+        }), "ns");
+    }
+}
+
+void printCsv() {
+    printf("name,param,value,unit\n");
+    for (const Result& r : results) {
+        printf("%s,%s,%.3f,%s\n", r.name.c_str(), r.param.c_str(), r.value, r.unit.c_str());
+    }
+}
+
+void printJson() {
+    printf("[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        printf("  {\"name\": \"%s\", \"param\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}%s\n", r.name.c_str(),
+               r.param.c_str(), r.value, r.unit.c_str(), i + 1 < results.size() ? "," : "");
+    }
+    printf("]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool json = argc > 1 && strcmp(argv[1], "--json") == 0;
+
+    MorseConverter morse(5, OutputMode::BOTH);
+
+    benchEncode();
+    benchDecode();
+    benchEcho(morse);
+    benchEchoCache(morse);
+    benchEchoStream(morse);
+    benchPlayback(morse);
+    benchWriteToFirstPulse(morse);
+    benchPresetStart(morse);
+
+    if (json) {
+        printJson();
+    } else {
+        printCsv();
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Host benchmark: SSE4/AVX2 bulk encoder vs its scalar fallback, plus a byte-identity
+// check of every kernel against encodeMorse.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I include -I host bench/bulk_encode_bench.cpp host/morse_bulk_encoder.cpp src/morse_encoder.cpp -o /tmp/bulk_encode_bench
+//   /tmp/bulk_encode_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "morse_bulk_encoder.h"
+#include "morse_encoder.h"
+
+// anyByte covers every 7-bit byte; the bulk encoder leaves UTF-8 to encodeMorse
+static std::string makeCorpus(size_t length, uint32_t seed, bool anyByte) {
+    static const char alphabet[] = "the quick brown fox jumps over the lazy dog THE QUICK BROWN FOX 0123456789 .,?!\n";
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+    std::uniform_int_distribution<int> byte(1, 127);
+    std::string corpus(length, ' ');
+    for (size_t i = 0; i < length; i++) {
+        corpus[i] = anyByte ? static_cast<char>(byte(rng)) : alphabet[pick(rng)];
+    }
+    return corpus;
+}
+
+static bool checkIdentical(BulkEncodeKernel kernel) {
+    for (uint32_t seed = 0; seed < 200; seed++) {
+        const std::string text = makeCorpus(seed * 7 % 301, seed, seed % 2 == 0);
+        std::string expected(morseEncodedLength(text.c_str()) + 1, '\0');
+        encodeMorse(text.c_str(), &expected[0], expected.size());
+        expected.resize(strlen(expected.c_str()));
+
+        std::vector<char> out(bulkEncodeCapacity(text.size()));
+        const size_t length = bulkEncode(text.data(), text.size(), out.data(), kernel);
+        if (std::string(out.data(), length) != expected) {
+            std::printf("%s output differs from encodeMorse (seed %u)\n", bulkEncodeKernelName(kernel), seed);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    const BulkEncodeKernel best = bulkEncodeBestKernel();
+    std::vector<BulkEncodeKernel> kernels = {BulkEncodeKernel::SCALAR};
+    if (best >= BulkEncodeKernel::SSE4) {
+        kernels.push_back(BulkEncodeKernel::SSE4);
+    }
+    if (best >= BulkEncodeKernel::AVX2) {
+        kernels.push_back(BulkEncodeKernel::AVX2);
+    }
+
+    for (BulkEncodeKernel kernel : kernels) {
+        if (!checkIdentical(kernel)) {
+            return 1;
+        }
+    }
+
+    const std::string corpus = makeCorpus(64u << 20, 11, false);
+    std::vector<char> out(bulkEncodeCapacity(corpus.size()));
+
+    double scalarSeconds = 0;
+    std::printf("%8s %12s %12s %9s\n", "kernel", "in GB/s", "out GB/s", "speedup");
+    for (BulkEncodeKernel kernel : kernels) {
+        double bestSeconds = 1e9;
+        size_t length = 0;
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            length = bulkEncode(corpus.data(), corpus.size(), out.data(), kernel);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            bestSeconds = seconds < bestSeconds ? seconds : bestSeconds;
+        }
+        if (kernel == BulkEncodeKernel::SCALAR) {
+            scalarSeconds = bestSeconds;
+        }
+        std::printf("%8s %12.2f %12.2f %8.2fx\n", bulkEncodeKernelName(kernel), corpus.size() / bestSeconds / 1e9,
+                    length / bestSeconds / 1e9, scalarSeconds / bestSeconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Host benchmark: MorseDecoder throughput on multi-megabyte ASCII and packed input,
+// against a reverse linear search over MORSE_TABLE.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I include bench/decode_bench.cpp src/morse_decoder.cpp src/morse_encoder.cpp src/packed_morse.cpp -o /tmp/decode_bench
+//   /tmp/decode_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "morse_decoder.h"
+#include "morse_encoder.h"
+
+// Decodes by collecting each letter's dots/dashes and scanning MORSE_TABLE for a match
+static size_t decodeLinear(const char* ascii, char* out) {
+    char code[8];
+    size_t codeLength = 0;
+    size_t written = 0;
+
+    for (size_t i = 0;; i++) {
+        const char c = ascii[i];
+        if (c == '.' || c == '-') {
+            if (codeLength < sizeof(code) - 1) {
+                code[codeLength++] = c;
+            }
+            continue;
+        }
+        if (codeLength > 0) {
+            code[codeLength] = '\0';
+            char letter = MORSE_DECODE_UNKNOWN;
+            for (int j = 0; j < MORSE_TABLE_SIZE; j++) {
+                if (strcmp(MORSE_TABLE[j].code, code) == 0) {
+                    letter = MORSE_TABLE[j].character;
+                    break;
+                }
+            }
+            out[written++] = letter;
+            codeLength = 0;
+        } else if (c == ' ' && written > 0 && out[written - 1] != ' ') {
+            out[written++] = ' ';
+        }
+        if (c == '\0') {
+            break;
+        }
+    }
+    out[written] = '\0';
+    return written;
+}
+
+static std::string makeText(size_t length, uint32_t seed) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789  ";
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+    std::string text(length, ' ');
+    for (size_t i = 0; i < length; i++) {
+        text[i] = alphabet[pick(rng)];
+    }
+    return text;
+}
+
+// Uppercase, single-spaced, trimmed: what a round trip through Morse should return
+static std::string normalize(const std::string& text) {
+    std::string result;
+    for (char c : text) {
+        if (c == ' ') {
+            if (!result.empty() && result.back() != ' ') {
+                result += ' ';
+            }
+        } else if (morseCodeFor(c)) {
+            result += c;
+        }
+    }
+    while (!result.empty() && result.back() == ' ') {
+        result.pop_back();
+    }
+    return result;
+}
+
+template <typename Decode>
+static double seconds(Decode decode) {
+    auto start = std::chrono::steady_clock::now();
+    decode();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const size_t lengths[] = {1u << 20, 4u << 20, 16u << 20};
+
+    std::printf("%10s %10s %14s %14s %14s\n", "text MB", "input", "linear MB/s", "tree MB/s", "tree Msym/s");
+    for (size_t length : lengths) {
+        const std::string text = makeText(length, 3);
+        const std::string expected = normalize(text);
+
+        // Word gaps become "  " in the legacy ASCII format
+        std::string ascii(morseEncodedLength(text.c_str()) + 1, '\0');
+        encodeMorse(text.c_str(), &ascii[0], ascii.size());
+        ascii.resize(strlen(ascii.c_str()));
+
+        std::vector<uint8_t> packed;
+        size_t symbols = 0;
+        MorseStreamEncoder encoder;
+        encoder.begin(text.c_str(), text.size());
+        MorseSymbol symbol;
+        while (encoder.next(symbol)) {
+            if ((symbols & 3) == 0) {
+                packed.push_back(0);
+            }
+            packed.back() |= static_cast<uint8_t>(symbol) << ((symbols & 3) * 2);
+            symbols++;
+        }
+
+        std::vector<char> out(text.size() + 1);
+        MorseDecoder decoder;
+
+        const double linear = seconds([&] { decodeLinear(ascii.c_str(), out.data()); });
+        const double asciiTree = seconds([&] { decoder.decode(ascii.c_str(), out.data(), out.size()); });
+        if (expected != out.data()) {
+            std::printf("ASCII decode mismatch at %zu bytes\n", length);
+            return 1;
+        }
+        const double packedTree = seconds([&] { decoder.decodePacked(packed.data(), symbols, out.data(), out.size()); });
+        if (expected != out.data()) {
+            std::printf("packed decode mismatch at %zu bytes\n", length);
+            return 1;
+        }
+
+        const double mb = text.size() / 1e6;
+        const double asciiMb = ascii.size() / 1e6;
+        std::printf("%10.1f %10s %14.1f %14.1f %14.1f\n", mb, "ascii", asciiMb / linear, asciiMb / asciiTree, ascii.size() / asciiTree / 1e6);
+        std::printf("%10.1f %10s %14s %14.1f %14.1f\n", mb, "packed", "-", packed.size() / 1e6 / packedTree, symbols / packedTree / 1e6);
+    }
+
+    return 0;
+}
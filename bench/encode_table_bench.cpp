@@ -0,0 +1,73 @@
+// Host benchmark: direct-indexed MORSE_ENCODE_INDEX vs the original linear scan.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I include bench/encode_table_bench.cpp -o /tmp/encode_table_bench
+//   /tmp/encode_table_bench
+
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <random>
+#include <string>
+#include "morse_code.h"
+
+// The pre-table implementation of MorseConverter::findMorseCode
+static const char* findMorseCodeLinear(char c) {
+    char upperChar = toupper(c);
+
+    for (int i = 0; i < MORSE_TABLE_SIZE; i++) {
+        if (MORSE_TABLE[i].character == upperChar) {
+            return MORSE_TABLE[i].code;
+        }
+    }
+    return nullptr;
+}
+
+static std::string makeMessage(size_t length, uint32_t seed) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789  .,?!";
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+    std::string message(length, ' ');
+    for (size_t i = 0; i < length; i++) {
+        message[i] = alphabet[pick(rng)];
+    }
+    return message;
+}
+
+template <typename Lookup>
+static double nsPerChar(const std::string& message, Lookup lookup, uintptr_t& sink) {
+    const size_t target = 8u << 20;  // ~8M lookups per measurement
+    const size_t rounds = message.size() >= target ? 1 : target / message.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (char c : message) {
+            sink += reinterpret_cast<uintptr_t>(lookup(c));
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double)(rounds * message.size());
+}
+
+int main() {
+    // Both lookups must agree on every byte before timing means anything
+    for (int c = 0; c < 256; c++) {
+        if (morseCodeFor(static_cast<char>(c)) != findMorseCodeLinear(static_cast<char>(c))) {
+            std::printf("mismatch at byte %d\n", c);
+            return 1;
+        }
+    }
+
+    const size_t lengths[] = {100, 1000, 10000, 100000, 1000000};
+    uintptr_t sink = 0;
+
+    std::printf("%10s %14s %14s %9s\n", "bytes", "linear ns/ch", "table ns/ch", "speedup");
+    for (size_t length : lengths) {
+        const std::string message = makeMessage(length, 42);
+        const double linear = nsPerChar(message, findMorseCodeLinear, sink);
+        const double table = nsPerChar(message, morseCodeFor, sink);
+        std::printf("%10zu %14.3f %14.3f %8.1fx\n", length, linear, table, linear / table);
+    }
+
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+// Host jitter comparison of the playback backends. Plays a fixed message while a
+// simulated main loop spends random time in BLE.poll() and other work, then again
+// with flash writes (saving presets) mixed in, and reports edge lateness from the
+// MORSE_JITTER_PROBE counters. Build once per backend:
+//
+//   pio run -e jitter_polled && .pio/build/jitter_polled/program
+//   pio run -e jitter_timer && .pio/build/jitter_timer/program
+
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "morse_converter.h"
+
+#ifndef MORSE_JITTER_PROBE
+#error "jitter_bench needs -D MORSE_JITTER_PROBE"
+#endif
+
+static const char MESSAGE[] = "SOS PARIS 73 CQ CQ DE MORSECODIFY";
+
+// Time one loop() pass spends outside updatePlayback(): mostly short polls,
+// some slower BLE events and the occasional long stall
+static uint64_t loopCostUs(std::mt19937& rng) {
+    const uint32_t roll = rng() % 100;
+    if (roll < 70) {
+        return 50 + rng() % 200;
+    }
+    if (roll < 95) {
+        return 1000 + rng() % 3000;
+    }
+    return 15000 + rng() % 15000;
+}
+
+// A flash write or erase (NVS saving a preset) every few passes: a few ms, sometimes
+// tens of ms for a sector erase. Nothing but IRAM interrupts runs meanwhile.
+static uint64_t flashWriteUs(std::mt19937& rng) {
+    if (rng() % 100 >= 3) {
+        return 0;
+    }
+    return rng() % 4 ? 5000 + rng() % 5000 : 20000 + rng() % 20000;
+}
+
+static void playMessage(MorseConverter& morse, const char* load, bool flashWrites) {
+    std::mt19937 rng(1234);
+    const uint64_t startUs = halMicros();
+    morse.startTextPlayback(MESSAGE, strlen(MESSAGE));
+    while (morse.isPlaybackActive()) {
+        morse.updatePlayback();
+        halAdvanceMicros(loopCostUs(rng));
+        if (flashWrites) {
+            halFlashOperation(flashWriteUs(rng));
+        }
+    }
+
+    const PlaybackJitterStats& stats = morse.getJitterStats();
+    printf("%s,%s,%u,%.1f,%u,%u,%llu\n", MORSE_PLAYBACK_BACKEND, load, stats.edges,
+           stats.edges ? static_cast<double>(stats.totalLatenessUs) / stats.edges : 0.0, stats.maxLatenessUs,
+           stats.maxIntervalErrorUs, static_cast<unsigned long long>((halMicros() - startUs) / 1000));
+}
+
+int main() {
+    MorseConverter morse(5, OutputMode::BOTH);
+    halReset();
+    halSetTraceEnabled(false);
+
+    printf("backend,load,edges,mean_lateness_us,max_lateness_us,max_interval_error_us,message_ms\n");
+    playMessage(morse, "busy_loop", false);
+    playMessage(morse, "flash_writes", true);
+    return 0;
+}
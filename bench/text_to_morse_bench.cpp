@@ -0,0 +1,78 @@
+// Host benchmark: strcat-based textToMorse vs the single-pass encodeMorse.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I include bench/text_to_morse_bench.cpp src/morse_encoder.cpp -o /tmp/text_to_morse_bench
+//   /tmp/text_to_morse_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "morse_encoder.h"
+
+// The pre-cursor implementation of MorseConverter::textToMorse, with an unbounded buffer
+static const char* textToMorseStrcat(const char* text, char* morseBuffer) {
+    morseBuffer[0] = '\0';
+
+    for (int i = 0; text[i] != '\0'; i++) {
+        if (i > 0) {
+            strcat(morseBuffer, " ");
+        }
+        const char* morseChar = morseCodeFor(text[i]);
+        if (morseChar) {
+            strcat(morseBuffer, morseChar);
+        }
+    }
+
+    return morseBuffer;
+}
+
+static std::string makeMessage(size_t length, uint32_t seed) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789 ";
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+    std::string message(length, ' ');
+    for (size_t i = 0; i < length; i++) {
+        message[i] = alphabet[pick(rng)];
+    }
+    return message;
+}
+
+template <typename Encode>
+static double nsPerChar(const std::string& message, Encode encode) {
+    const size_t target = 1u << 22;
+    const size_t rounds = message.size() >= target ? 1 : target / message.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        encode(message.c_str());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double)(rounds * message.size());
+}
+
+int main() {
+    const size_t lengths[] = {16, 64, 256, 1024, 4096, 16384};
+
+    std::printf("%8s %16s %16s %9s\n", "bytes", "strcat ns/ch", "cursor ns/ch", "speedup");
+    for (size_t length : lengths) {
+        const std::string message = makeMessage(length, 7);
+        const size_t encoded = morseEncodedLength(message.c_str());
+        std::vector<char> a(encoded + 1), b(encoded + 1);
+
+        textToMorseStrcat(message.c_str(), a.data());
+        const MorseEncodeResult result = encodeMorse(message.c_str(), b.data(), b.size());
+        if (result.truncated || result.length != encoded || strcmp(a.data(), b.data()) != 0) {
+            std::printf("output mismatch at %zu bytes\n", length);
+            return 1;
+        }
+
+        const double quadratic = nsPerChar(message, [&](const char* text) { textToMorseStrcat(text, a.data()); });
+        const double linear = nsPerChar(message, [&](const char* text) { encodeMorse(text, b.data(), b.size()); });
+        std::printf("%8zu %16.2f %16.2f %8.1fx\n", length, quadratic, linear, quadratic / linear);
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+// Host loopback of the framed transfer protocol (message_transfer.h). A windowed
+// sender streams a multi-kilobyte message to the firmware's TransferReceiver over a
+// mock BLE link and checks the reassembled bytes; throughput is reported per window
+// size, with and without dropped frames.
+//
+// The link model is per connection event: each event carries up to
+// LL_PACKETS_PER_EVENT link-layer packets of up to LL_PAYLOAD bytes from the central,
+// and acks notified during one event reach the sender at the next.
+//
+//   g++ -O2 -std=gnu++17 -I include bench/transfer_loopback_bench.cpp src/message_transfer.cpp -o transfer_bench
+
+#include <stdio.h>
+#include <string.h>
+#include <deque>
+#include <random>
+#include <vector>
+#include "message_transfer.h"
+
+namespace {
+
+const uint32_t CONN_INTERVAL_US = 15000;
+const size_t LL_PACKETS_PER_EVENT = 6;
+const size_t LL_PAYLOAD = 251;   // With data length extension
+const size_t L2CAP_ATT_OVERHEAD = 4 + 3;
+const uint32_t TIMEOUT_EVENTS = 4;
+const size_t MESSAGE_LENGTH = MORSE_TRANSFER_MAX;
+const uint32_t MAX_EVENTS = 100000;
+
+struct Frame {
+    std::vector<uint8_t> bytes;
+};
+
+// Sender with a window of unacknowledged chunks. A repeated ack resends just the
+// chunk the receiver is missing (it keeps the ones after it); if neither acks nor
+// new chunks have moved for TIMEOUT_EVENTS it goes back and resends from there.
+class WindowedSender {
+private:
+    const std::vector<uint8_t>& message;
+    uint8_t id;
+    uint16_t chunkSize;
+    uint16_t chunkCount;
+    uint8_t window;
+    bool started = false;    // START acknowledged
+    bool startSent = false;
+    uint16_t acked = 0;      // Receiver's next expected chunk
+    uint16_t next = 0;       // Next chunk to send
+    uint16_t highestSent = 0;
+    bool resendMissing = false;
+    int32_t lastFastResend = -1;  // Chunk already resent for a repeated ack
+    uint32_t lastProgressEvent = 0;  // Last ack progress or first send of a chunk
+
+public:
+    bool done = false;
+    TransferStatus result = TransferStatus::IN_PROGRESS;
+    uint32_t framesSent = 0;
+    uint32_t resends = 0;
+
+    WindowedSender(const std::vector<uint8_t>& message, uint8_t id, uint16_t chunkSize, uint8_t window)
+        : message(message), id(id), chunkSize(chunkSize), window(window) {
+        chunkCount = (message.size() + chunkSize - 1) / chunkSize;
+    }
+
+    bool nextFrame(Frame& frame, uint32_t event) {
+        if (done) {
+            return false;
+        }
+        if (!started) {
+            if (startSent && event - lastProgressEvent < TIMEOUT_EVENTS) {
+                return false;
+            }
+            const uint16_t total = message.size();
+            frame.bytes = {TRANSFER_START, id, 0, 0, uint8_t(total), uint8_t(total >> 8),
+                           uint8_t(chunkSize), uint8_t(chunkSize >> 8), window};
+            startSent = true;
+            lastProgressEvent = event;
+            framesSent++;
+            return true;
+        }
+
+        if (event - lastProgressEvent >= TIMEOUT_EVENTS && next > acked) {
+            resends += next - acked;
+            next = acked;
+            lastProgressEvent = event;
+        }
+        uint16_t chunk = next;
+        if (resendMissing) {
+            resendMissing = false;
+            chunk = acked;
+            resends++;
+        } else if (next >= chunkCount || next - acked >= window) {
+            return false;
+        }
+
+        const size_t offset = size_t(chunk) * chunkSize;
+        const size_t length = std::min<size_t>(chunkSize, message.size() - offset);
+        frame.bytes = {TRANSFER_DATA, id, uint8_t(chunk), uint8_t(chunk >> 8)};
+        frame.bytes.insert(frame.bytes.end(), message.begin() + offset, message.begin() + offset + length);
+        framesSent++;
+        if (chunk != next) {
+            return true;
+        }
+        next++;
+        if (next > highestSent) {
+            highestSent = next;
+            lastProgressEvent = event;
+        }
+        return true;
+    }
+
+    void onAck(const uint8_t* value, uint32_t event) {
+        if (value[0] != id) {
+            return;
+        }
+        const TransferStatus status = static_cast<TransferStatus>(value[1]);
+        const uint16_t nextExpected = value[2] | value[3] << 8;
+        if (status != TransferStatus::IN_PROGRESS) {
+            done = true;
+            result = status;
+            return;
+        }
+        if (!started) {
+            started = true;
+            lastProgressEvent = event;
+            return;
+        }
+        if (nextExpected > acked) {
+            acked = nextExpected;
+            lastProgressEvent = event;
+        } else if (next > acked && lastFastResend != acked) {
+            // Repeated ack: a chunk went missing
+            resendMissing = true;
+            lastFastResend = acked;
+        }
+    }
+};
+
+struct Run {
+    uint32_t events;
+    uint32_t frames;
+    uint32_t resends;
+    bool ok;
+};
+
+Run runTransfer(const std::vector<uint8_t>& message, uint16_t mtu, uint8_t window, double dropRate, uint32_t seed) {
+    static TransferReceiver receiver;
+    receiver.reset();
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> roll(0, 1);
+
+    const uint16_t chunkSize = mtu - 3 - TRANSFER_HEADER_SIZE;
+    WindowedSender sender(message, 0x42, chunkSize, window);
+    std::deque<std::vector<uint8_t>> acksInFlight;  // Delivered at the next event
+    Frame frame;
+    bool holding = false;  // frame did not fit into the last event
+
+    uint32_t event = 0;
+    for (; event < MAX_EVENTS && !sender.done; event++) {
+        std::deque<std::vector<uint8_t>> delivered;
+        delivered.swap(acksInFlight);
+        for (const std::vector<uint8_t>& ack : delivered) {
+            sender.onAck(ack.data(), event);
+        }
+
+        size_t budget = LL_PACKETS_PER_EVENT;
+        while (budget > 0) {
+            if (!holding && !sender.nextFrame(frame, event)) {
+                break;
+            }
+            const size_t packets = (frame.bytes.size() + L2CAP_ATT_OVERHEAD + LL_PAYLOAD - 1) / LL_PAYLOAD;
+            holding = packets > budget;
+            if (holding) {
+                break;
+            }
+            budget -= packets;
+
+            if (roll(rng) < dropRate) {
+                continue;  // Lost in a full receive queue
+            }
+            TransferAck ack;
+            if (receiver.receive(frame.bytes.data(), frame.bytes.size(), ack)) {
+                std::vector<uint8_t> value(TRANSFER_ACK_SIZE);
+                ack.encode(value.data());
+                acksInFlight.push_back(value);
+            }
+        }
+    }
+
+    const bool ok = sender.result == TransferStatus::COMPLETE && receiver.length() == message.size()
+                    && memcmp(receiver.data(), message.data(), message.size()) == 0;
+    return {event, sender.framesSent, sender.resends, ok};
+}
+
+} // namespace
+
+int main() {
+    std::vector<uint8_t> message(MESSAGE_LENGTH);
+    for (size_t i = 0; i < message.size(); i++) {
+        message[i] = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG "[i % 44];
+    }
+
+    // The single-write path: one 100-byte textInputChar write with response per message
+    const double baselineKBps = 100.0 / (2.0 * CONN_INTERVAL_US / 1e6) / 1000.0;
+    printf("link: %u us interval, %zu LL packets/event; %zu-byte message\n", CONN_INTERVAL_US, LL_PACKETS_PER_EVENT,
+           message.size());
+    printf("baseline single writes: %.1f kB/s\n\n", baselineKBps);
+    printf("%-5s %-7s %-6s %8s %8s %8s %10s %s\n", "mtu", "window", "drop", "events", "frames", "resends", "kB/s",
+           "data");
+
+    bool allOk = true;
+    const uint16_t mtus[] = {23, 185, 512};
+    const uint8_t windows[] = {1, 2, 4, 8, 16, 32};
+    const double drops[] = {0.0, 0.02};
+    for (uint16_t mtu : mtus) {
+        for (double drop : drops) {
+            for (uint8_t window : windows) {
+                const Run run = runTransfer(message, mtu, window, drop, 1234 + window);
+                const double seconds = run.events * CONN_INTERVAL_US / 1e6;
+                printf("%-5u %-7u %-6.2f %8u %8u %8u %10.1f %s\n", mtu, window, drop, run.events, run.frames,
+                       run.resends, message.size() / seconds / 1000.0, run.ok ? "OK" : "MISMATCH");
+                allOk = allOk && run.ok;
+            }
+        }
+    }
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// Host benchmark: the UTF-8 encoders against their ASCII-only predecessors on pure
+// ASCII text, where the fast path should keep them level, plus the cost per code
+// point of each non-Latin alphabet.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I include bench/utf8_encode_bench.cpp src/morse_encoder.cpp -o /tmp/utf8_encode_bench
+//   /tmp/utf8_encode_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "morse_encoder.h"
+
+// The pre-UTF-8 encodeMorse: one table lookup per byte. Both copies of the old code
+// stay out of line, as the library functions they are compared with are.
+__attribute__((noinline)) static size_t encodeMorseBytewise(const char* text, char* out, size_t outSize) {
+    char* cursor = out;
+    char* const end = out + outSize - 1;
+
+    for (size_t i = 0; text[i] != '\0'; i++) {
+        const char* code = morseCodeFor(text[i]);
+        const size_t codeLength = packedCodeFor(text[i]).length;
+        const size_t needed = codeLength + (i > 0 ? 1 : 0);
+        if (needed > (size_t)(end - cursor)) {
+            break;
+        }
+        if (i > 0) {
+            *cursor++ = ' ';
+        }
+        for (size_t j = 0; j < codeLength; j++) {
+            *cursor++ = code[j];
+        }
+    }
+    *cursor = '\0';
+    return cursor - out;
+}
+
+// The pre-UTF-8 MorseStreamEncoder::next, one byte per character
+class BytewiseStreamEncoder {
+private:
+    const char* text = nullptr;
+    size_t textLength = 0;
+    size_t position = 0;
+    PackedCode code = {0, 0};
+    uint8_t symbolIndex = 0;
+    bool started = false;
+
+public:
+    void begin(const char* text, size_t length) {
+        this->text = text;
+        textLength = length;
+    }
+
+    __attribute__((noinline)) bool next(MorseSymbol& symbol) {
+        if (symbolIndex < code.length) {
+            symbol = (code.bits >> symbolIndex++) & 1 ? MorseSymbol::DASH : MorseSymbol::DOT;
+            return true;
+        }
+        bool crossedSpace = false;
+        while (position < textLength) {
+            const char c = text[position++];
+            if (c == ' ') {
+                crossedSpace = true;
+                continue;
+            }
+            const PackedCode nextCode = packedCodeFor(c);
+            if (nextCode.length == 0) {
+                continue;
+            }
+            code = nextCode;
+            symbolIndex = 0;
+            if (started) {
+                symbol = crossedSpace ? MorseSymbol::WORD_GAP : MorseSymbol::LETTER_GAP;
+                return true;
+            }
+            started = true;
+            return next(symbol);
+        }
+        return false;
+    }
+};
+
+// Sums the symbols so neither loop can be optimised away
+template <typename Encoder>
+static size_t drain(Encoder& encoder) {
+    MorseSymbol symbol;
+    size_t sum = 0;
+    while (encoder.next(symbol)) {
+        sum += static_cast<size_t>(symbol) + 1;
+    }
+    return sum;
+}
+
+static size_t streamBytewise(const char* text, size_t length) {
+    BytewiseStreamEncoder encoder;
+    encoder.begin(text, length);
+    return drain(encoder);
+}
+
+static size_t streamUtf8(const char* text, size_t length, MorseAlphabet alphabet) {
+    MorseStreamEncoder encoder;
+    encoder.begin(text, length, alphabet);
+    return drain(encoder);
+}
+
+static std::string makeAscii(size_t length, uint32_t seed) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789 .,?!";
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+    std::string message(length, ' ');
+    for (size_t i = 0; i < length; i++) {
+        message[i] = alphabet[pick(rng)];
+    }
+    return message;
+}
+
+// Whole words of sample, repeated to at least length bytes
+static std::string repeatSample(const char* sample, size_t length) {
+    std::string message;
+    while (message.size() < length) {
+        message += sample;
+    }
+    return message;
+}
+
+static const int REPEATS = 5;
+
+template <typename Encode>
+static double nsPerByte(const std::string& message, Encode encode, size_t& sink) {
+    const size_t target = 1u << 21;
+    const size_t rounds = message.size() >= target ? 1 : target / message.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        sink += encode(message.c_str(), message.size());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double)(rounds * message.size());
+}
+
+static size_t codePoints(const std::string& text) {
+    size_t count = 0;
+    for (size_t i = 0; i < text.size();) {
+        uint32_t codePoint;
+        i += decodeUtf8(text.data() + i, text.size() - i, codePoint);
+        count++;
+    }
+    return count;
+}
+
+int main() {
+    const size_t lengths[] = {64, 256, 1024, 4096, 16384};
+    size_t sink = 0;
+
+    std::printf("Pure ASCII, ns/byte (bytewise = before UTF-8 decoding)\n");
+    std::printf("%8s %14s %14s %14s %14s\n", "bytes", "ascii bytewise", "ascii utf8", "stream bytewise",
+                "stream utf8");
+    for (size_t length : lengths) {
+        const std::string message = makeAscii(length, 11);
+        std::vector<char> a(morseEncodedLength(message.c_str()) + 1), b(a.size());
+
+        // Identical output before timing means anything
+        encodeMorseBytewise(message.c_str(), a.data(), a.size());
+        encodeMorse(message.c_str(), b.data(), b.size());
+        if (strcmp(a.data(), b.data()) != 0
+            || streamBytewise(message.c_str(), length) != streamUtf8(message.c_str(), length, MorseAlphabet::LATIN)) {
+            std::printf("output mismatch at %zu bytes\n", length);
+            return 1;
+        }
+
+        // Best of interleaved repeats, so warm-up and frequency drift favour neither side
+        double best[4] = {1e9, 1e9, 1e9, 1e9};
+        for (int repeat = 0; repeat < REPEATS; repeat++) {
+            const double times[4] = {
+                nsPerByte(message, [&](const char* text, size_t) {
+                    return encodeMorseBytewise(text, a.data(), a.size());
+                }, sink),
+                nsPerByte(message, [&](const char* text, size_t) {
+                    return encodeMorse(text, b.data(), b.size()).length;
+                }, sink),
+                nsPerByte(message, streamBytewise, sink),
+                nsPerByte(message, [](const char* text, size_t size) {
+                    return streamUtf8(text, size, MorseAlphabet::LATIN);
+                }, sink),
+            };
+            for (int i = 0; i < 4; i++) {
+                best[i] = times[i] < best[i] ? times[i] : best[i];
+            }
+        }
+        std::printf("%8zu %14.3f %14.3f %14.3f %14.3f\n", length, best[0], best[1], best[2], best[3]);
+    }
+
+    struct Sample {
+        const char* name;
+        MorseAlphabet alphabet;
+        const char* text;
+    };
+    static const Sample samples[] = {
+        {"latin", MorseAlphabet::LATIN, "Ça va très bien, grüße aus Köln "},
+        {"cyrillic", MorseAlphabet::CYRILLIC, "Привет мир "},
+        {"greek", MorseAlphabet::GREEK, "Καλημέρα κόσμε "},
+        {"wabun", MorseAlphabet::WABUN, "コンニチハ こんばんは "},
+    };
+
+    std::printf("\nUTF-8 text, 16 KiB per sample\n");
+    std::printf("%10s %14s %14s\n", "alphabet", "ascii ns/cp", "stream ns/cp");
+    for (const Sample& sample : samples) {
+        const std::string message = repeatSample(sample.text, 16384);
+        const double perCodePoint = (double)message.size() / codePoints(message);
+        std::vector<char> out(morseEncodedLength(message.c_str(), sample.alphabet) + 1);
+        const double ascii = nsPerByte(message, [&](const char* text, size_t) {
+            return encodeMorse(text, out.data(), out.size(), sample.alphabet).length;
+        }, sink);
+        const double stream = nsPerByte(message, [&](const char* text, size_t size) {
+            return streamUtf8(text, size, sample.alphabet);
+        }, sink);
+        std::printf("%10s %14.3f %14.3f\n", sample.name, ascii * perCodePoint, stream * perCodePoint);
+    }
+
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+#ifndef ARDUINO_SHIM_H
+#define ARDUINO_SHIM_H
+
+// Minimal Arduino/ESP32 core for the native build. Time comes from the virtual
+// clock in hal_shim.h; GPIO and LEDC writes are recorded in its trace.
+
+#include <ctype.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "esp_attr.h"
+#include "hal_shim.h"
+
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+#define F(string_literal) (string_literal)
+
+using std::max;
+using std::min;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+double ledcSetup(uint8_t channel, double freq, uint8_t resolution_bits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+
+int xPortGetCoreID();
+
+// ESP32 hardware timers; alarms fire from halAdvanceMicros when the virtual clock
+// reaches them. Their interrupts are not IRAM-safe, so halFlashOperation() holds them off.
+struct hw_timer_t;
+hw_timer_t* timerBegin(uint8_t num, uint16_t divider, bool countUp);
+void timerEnd(hw_timer_t* timer);
+void timerAttachInterrupt(hw_timer_t* timer, void (*fn)(void), bool edge);
+void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool autoreload);
+void timerAlarmEnable(hw_timer_t* timer);
+void timerAlarmDisable(hw_timer_t* timer);
+void timerWrite(hw_timer_t* timer, uint64_t value);
+uint64_t timerRead(hw_timer_t* timer);
+
+// Everything runs on one host thread, so critical sections are no-ops
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+
+// Serial output goes to stdout
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+    explicit operator bool() const { return true; }
+
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(int n) { return print(static_cast<long>(n)); }
+    size_t print(unsigned int n) { return print(static_cast<unsigned long>(n)); }
+    size_t print(double n);
+
+    size_t println();
+    template <typename T>
+    size_t println(T value) {
+        const size_t written = print(value);
+        return written + println();
+    }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HardwareSerial Serial;
+
+#endif // ARDUINO_SHIM_H
@@ -0,0 +1,46 @@
+#ifndef DRIVER_TIMER_SHIM_H
+#define DRIVER_TIMER_SHIM_H
+
+// ESP-IDF general purpose timer driver on the shim's virtual clock. Timers are
+// shared with timerBegin() in Arduino.h: group g, timer t is timer number g * 2 + t.
+// As in the IDF driver, an alarm is disabled when it fires and re-enabled after
+// the callback only if the callback moved it.
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERR_INVALID_ARG 0x102
+
+// From esp_intr_alloc.h on the device
+#define ESP_INTR_FLAG_IRAM (1 << 10)  // Keeps running while flash is busy; see halFlashOperation()
+
+enum timer_group_t { TIMER_GROUP_0, TIMER_GROUP_1 };
+enum timer_idx_t { TIMER_0, TIMER_1 };
+enum timer_start_t { TIMER_PAUSE, TIMER_START };
+enum timer_alarm_t { TIMER_ALARM_DIS, TIMER_ALARM_EN };
+enum timer_intr_mode_t { TIMER_INTR_LEVEL };
+enum timer_count_dir_t { TIMER_COUNT_DOWN, TIMER_COUNT_UP };
+enum timer_autoreload_t { TIMER_AUTORELOAD_DIS, TIMER_AUTORELOAD_EN };
+
+struct timer_config_t {
+    timer_alarm_t alarm_en;
+    timer_start_t counter_en;
+    timer_intr_mode_t intr_type;
+    timer_count_dir_t counter_dir;
+    timer_autoreload_t auto_reload;
+    uint32_t divider;
+};
+
+typedef bool (*timer_isr_t)(void* arg);  // Returns whether a higher priority task was woken
+
+esp_err_t timer_init(timer_group_t group, timer_idx_t timer, const timer_config_t* config);
+esp_err_t timer_set_counter_value(timer_group_t group, timer_idx_t timer, uint64_t value);
+esp_err_t timer_get_counter_value(timer_group_t group, timer_idx_t timer, uint64_t* value);
+esp_err_t timer_set_alarm_value(timer_group_t group, timer_idx_t timer, uint64_t value);
+esp_err_t timer_set_alarm(timer_group_t group, timer_idx_t timer, timer_alarm_t alarm);
+esp_err_t timer_isr_callback_add(timer_group_t group, timer_idx_t timer, timer_isr_t isr, void* arg, int flags);
+esp_err_t timer_start(timer_group_t group, timer_idx_t timer);
+void timer_group_set_alarm_value_in_isr(timer_group_t group, timer_idx_t timer, uint64_t value);
+
+#endif // DRIVER_TIMER_SHIM_H
@@ -0,0 +1,7 @@
+#ifndef ESP_ATTR_SHIM_H
+#define ESP_ATTR_SHIM_H
+
+// Code placement is meaningless on the host; everything is "in IRAM"
+#define IRAM_ATTR
+
+#endif // ESP_ATTR_SHIM_H
@@ -0,0 +1,19 @@
+#ifndef HAL_GPIO_LL_SHIM_H
+#define HAL_GPIO_LL_SHIM_H
+
+// Register-level GPIO as used from IRAM code; writes land in the shim trace like digitalWrite()
+
+#include <stdint.h>
+#include "Arduino.h"
+
+enum gpio_num_t : int {};
+
+struct gpio_dev_t {};
+extern gpio_dev_t GPIO;
+
+static inline void gpio_ll_set_level(gpio_dev_t* hw, gpio_num_t gpio_num, uint32_t level) {
+    (void)hw;
+    digitalWrite(static_cast<uint8_t>(gpio_num), level ? HIGH : LOW);
+}
+
+#endif // HAL_GPIO_LL_SHIM_H
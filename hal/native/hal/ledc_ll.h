@@ -0,0 +1,40 @@
+#ifndef HAL_LEDC_LL_SHIM_H
+#define HAL_LEDC_LL_SHIM_H
+
+// Register-level LEDC as used from IRAM code. The duty written is latched by
+// ledc_ll_ls_channel_update() and lands in the shim trace like ledcWrite().
+
+#include <stdint.h>
+#include "Arduino.h"
+
+enum ledc_mode_t { LEDC_LOW_SPEED_MODE };
+enum ledc_channel_t { LEDC_CHANNEL_0, LEDC_CHANNEL_1, LEDC_CHANNEL_2, LEDC_CHANNEL_3,
+                      LEDC_CHANNEL_4, LEDC_CHANNEL_5, LEDC_CHANNEL_6, LEDC_CHANNEL_7 };
+
+struct ledc_dev_t {
+    uint32_t duty[8];  // Duty set but not yet latched, per low speed channel
+};
+extern ledc_dev_t LEDC;
+
+#define LEDC_LL_GET_HW() (&LEDC)
+
+static inline void ledc_ll_set_duty_int_part(ledc_dev_t* hw, ledc_mode_t speed_mode, ledc_channel_t channel_num,
+                                             uint32_t duty_val) {
+    (void)speed_mode;
+    hw->duty[channel_num] = duty_val;
+}
+
+static inline void ledc_ll_set_duty_start(ledc_dev_t* hw, ledc_mode_t speed_mode, ledc_channel_t channel_num,
+                                          bool duty_start) {
+    (void)hw;
+    (void)speed_mode;
+    (void)channel_num;
+    (void)duty_start;
+}
+
+static inline void ledc_ll_ls_channel_update(ledc_dev_t* hw, ledc_mode_t speed_mode, ledc_channel_t channel_num) {
+    (void)speed_mode;
+    ledcWrite(channel_num, hw->duty[channel_num]);
+}
+
+#endif // HAL_LEDC_LL_SHIM_H
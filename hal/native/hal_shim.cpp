@@ -0,0 +1,379 @@
+#include "Arduino.h"
+#include <driver/timer.h>
+#include <hal/gpio_ll.h>
+#include <hal/ledc_ll.h>
+#include <stdarg.h>
+#include <iterator>
+#include <new>
+
+HardwareSerial Serial;
+gpio_dev_t GPIO;
+ledc_dev_t LEDC;
+
+// Counts in 80 MHz / divider ticks from the virtual clock
+struct hw_timer_t {
+    bool used;
+    uint16_t divider;
+    uint64_t originUs;   // Virtual time at which the count was 0
+    uint64_t alarm;      // In timer ticks
+    bool alarmEnabled;
+    bool autoreload;
+    void (*isr)(void);          // timerAttachInterrupt()
+    timer_isr_t callback;       // timer_isr_callback_add()
+    void* arg;
+    bool iram;                  // Runs while flash is busy
+};
+
+namespace {
+
+uint64_t nowUs = 0;
+uint64_t allocations = 0;
+bool traceEnabled = true;
+bool flashBusy = false;
+std::vector<HalEvent> trace;
+int digitalLevels[256];      // LOW until written
+uint32_t ledcDuties[256];
+
+const int TIMER_COUNT = 4;
+hw_timer_t timers[TIMER_COUNT];
+
+uint64_t ticksToUs(const hw_timer_t& timer, uint64_t ticks) {
+    return ticks * timer.divider / 80;
+}
+
+// Earliest enabled alarm due at or before limitUs, or nullptr
+hw_timer_t* nextDueTimer(uint64_t limitUs) {
+    hw_timer_t* due = nullptr;
+    uint64_t dueUs = 0;
+    for (hw_timer_t& timer : timers) {
+        if (!timer.used || !timer.alarmEnabled || (!timer.isr && !timer.callback) || (flashBusy && !timer.iram)) {
+            continue;
+        }
+        const uint64_t alarmUs = timer.originUs + ticksToUs(timer, timer.alarm);
+        if (alarmUs <= limitUs && (!due || alarmUs < dueUs)) {
+            due = &timer;
+            dueUs = alarmUs;
+        }
+    }
+    return due;
+}
+
+void record(HalEventType type, uint8_t pin, uint32_t value) {
+    if (traceEnabled) {
+        trace.push_back({nowUs, type, pin, value});
+    }
+}
+
+} // namespace
+
+void halReset() {
+    nowUs = 0;
+    traceEnabled = true;
+    trace.clear();
+    std::fill(std::begin(digitalLevels), std::end(digitalLevels), LOW);
+    std::fill(std::begin(ledcDuties), std::end(ledcDuties), 0);
+    for (hw_timer_t& timer : timers) {
+        timer.originUs = 0;
+        timer.alarmEnabled = false;
+    }
+}
+
+uint64_t halMicros() {
+    return nowUs;
+}
+
+void halAdvanceMicros(uint64_t us) {
+    const uint64_t targetUs = nowUs + us;
+
+    // Fire due alarms in order, each at its exact time
+    while (hw_timer_t* timer = nextDueTimer(targetUs)) {
+        const uint64_t alarmUs = timer->originUs + ticksToUs(*timer, timer->alarm);
+        if (alarmUs > nowUs) {
+            nowUs = alarmUs;
+        }
+        if (timer->autoreload) {
+            timer->originUs = nowUs;
+        } else {
+            timer->alarmEnabled = false;
+        }
+        if (timer->isr) {
+            timer->isr();
+        } else {
+            // The IDF driver re-arms the alarm only if the callback moved it
+            const uint64_t fired = timer->alarm;
+            timer->callback(timer->arg);
+            if (timer->alarm != fired) {
+                timer->alarmEnabled = true;
+            }
+        }
+    }
+    nowUs = targetUs;
+}
+
+void halFlashOperation(uint64_t us) {
+    flashBusy = true;
+    halAdvanceMicros(us);
+    flashBusy = false;
+    halAdvanceMicros(0);
+}
+
+void halAdvanceMillis(uint64_t ms) {
+    halAdvanceMicros(ms * 1000);
+}
+
+void halSetTraceEnabled(bool enabled) {
+    traceEnabled = enabled;
+}
+
+const std::vector<HalEvent>& halTrace() {
+    return trace;
+}
+
+void halClearTrace() {
+    trace.clear();
+}
+
+uint64_t halAllocations() {
+    return allocations;
+}
+
+// The host envs link with --wrap=malloc,--wrap=realloc,--wrap=calloc, so every C
+// allocation in the program's own objects lands here; on the device Arduino String
+// grows through realloc. operator new allocates through the wrapped malloc.
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_realloc(void* p, size_t size);
+void* __real_calloc(size_t count, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+    allocations++;
+    return __real_realloc(p, size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+}
+
+// Array forms forward to the scalar ones; nothing here needs over-aligned types
+void* operator new(size_t size) {
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+int halDigitalLevel(uint8_t pin) {
+    return digitalLevels[pin];
+}
+
+uint32_t halLedcDuty(uint8_t channel) {
+    return ledcDuties[channel];
+}
+
+unsigned long millis() {
+    return static_cast<unsigned long>(nowUs / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(nowUs);
+}
+
+// Blocking waits move the virtual clock, so their cost shows up in the trace
+void delay(unsigned long ms) {
+    halAdvanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+    halAdvanceMicros(us);
+}
+
+void yield() {
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    record(HalEventType::PIN_MODE, pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    digitalLevels[pin] = val;
+    record(HalEventType::DIGITAL_WRITE, pin, val);
+}
+
+double ledcSetup(uint8_t channel, double freq, uint8_t resolution_bits) {
+    (void)channel;
+    (void)resolution_bits;
+    return freq;
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel) {
+    (void)pin;
+    (void)channel;
+}
+
+void ledcWrite(uint8_t channel, uint32_t duty) {
+    ledcDuties[channel] = duty;
+    record(HalEventType::LEDC_WRITE, channel, duty);
+}
+
+int xPortGetCoreID() {
+    return 0;
+}
+
+hw_timer_t* timerBegin(uint8_t num, uint16_t divider, bool countUp) {
+    (void)countUp;
+    if (num >= TIMER_COUNT) {
+        return nullptr;
+    }
+    timers[num] = {true, divider, nowUs, 0, false, false, nullptr, nullptr, nullptr, false};
+    return &timers[num];
+}
+
+void timerEnd(hw_timer_t* timer) {
+    timer->used = false;
+}
+
+void timerAttachInterrupt(hw_timer_t* timer, void (*fn)(void), bool edge) {
+    (void)edge;
+    timer->isr = fn;
+}
+
+void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool autoreload) {
+    timer->alarm = alarmValue;
+    timer->autoreload = autoreload;
+}
+
+void timerAlarmEnable(hw_timer_t* timer) {
+    timer->alarmEnabled = true;
+}
+
+void timerAlarmDisable(hw_timer_t* timer) {
+    timer->alarmEnabled = false;
+}
+
+void timerWrite(hw_timer_t* timer, uint64_t value) {
+    timer->originUs = nowUs - ticksToUs(*timer, value);
+}
+
+uint64_t timerRead(hw_timer_t* timer) {
+    return (nowUs - timer->originUs) * 80 / timer->divider;
+}
+
+static hw_timer_t* idfTimer(timer_group_t group, timer_idx_t timer) {
+    return &timers[group * 2 + timer];
+}
+
+esp_err_t timer_init(timer_group_t group, timer_idx_t timer, const timer_config_t* config) {
+    hw_timer_t* t = idfTimer(group, timer);
+    *t = {true, static_cast<uint16_t>(config->divider), nowUs, 0, config->alarm_en == TIMER_ALARM_EN,
+          config->auto_reload == TIMER_AUTORELOAD_EN, nullptr, nullptr, nullptr, false};
+    return ESP_OK;
+}
+
+esp_err_t timer_set_counter_value(timer_group_t group, timer_idx_t timer, uint64_t value) {
+    timerWrite(idfTimer(group, timer), value);
+    return ESP_OK;
+}
+
+esp_err_t timer_get_counter_value(timer_group_t group, timer_idx_t timer, uint64_t* value) {
+    *value = timerRead(idfTimer(group, timer));
+    return ESP_OK;
+}
+
+esp_err_t timer_set_alarm_value(timer_group_t group, timer_idx_t timer, uint64_t value) {
+    idfTimer(group, timer)->alarm = value;
+    return ESP_OK;
+}
+
+esp_err_t timer_set_alarm(timer_group_t group, timer_idx_t timer, timer_alarm_t alarm) {
+    idfTimer(group, timer)->alarmEnabled = alarm == TIMER_ALARM_EN;
+    return ESP_OK;
+}
+
+esp_err_t timer_isr_callback_add(timer_group_t group, timer_idx_t timer, timer_isr_t isr, void* arg, int flags) {
+    hw_timer_t* t = idfTimer(group, timer);
+    t->callback = isr;
+    t->arg = arg;
+    t->iram = flags & ESP_INTR_FLAG_IRAM;
+    return ESP_OK;
+}
+
+esp_err_t timer_start(timer_group_t group, timer_idx_t timer) {
+    (void)group;
+    (void)timer;
+    return ESP_OK;  // The virtual clock always runs
+}
+
+void timer_group_set_alarm_value_in_isr(timer_group_t group, timer_idx_t timer, uint64_t value) {
+    idfTimer(group, timer)->alarm = value;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    (void)baud;
+}
+
+size_t HardwareSerial::print(const char* s) {
+    return fputs(s, stdout) < 0 ? 0 : strlen(s);
+}
+
+size_t HardwareSerial::print(char c) {
+    return putchar(c) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::print(long n) {
+    return ::printf("%ld", n);
+}
+
+size_t HardwareSerial::print(unsigned long n) {
+    return ::printf("%lu", n);
+}
+
+size_t HardwareSerial::print(double n) {
+    return ::printf("%.2f", n);
+}
+
+size_t HardwareSerial::println() {
+    return print('\n');
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const int written = vprintf(format, args);
+    va_end(args);
+    return written < 0 ? 0 : written;
+}
@@ -0,0 +1,45 @@
+#ifndef HAL_SHIM_H
+#define HAL_SHIM_H
+
+#include <stdint.h>
+#include <vector>
+
+// Host-side control of the Arduino shim: a virtual clock that only moves when
+// told to, and a trace of every GPIO and LEDC write stamped with that clock.
+
+enum class HalEventType : uint8_t {
+    PIN_MODE,
+    DIGITAL_WRITE,
+    LEDC_WRITE
+};
+
+struct HalEvent {
+    uint64_t timeUs;
+    HalEventType type;
+    uint8_t pin;     // GPIO pin, or LEDC channel for LEDC_WRITE
+    uint32_t value;
+};
+
+void halReset();  // Clock back to 0, trace cleared and enabled
+
+uint64_t halMicros();
+void halAdvanceMicros(uint64_t us);
+void halAdvanceMillis(uint64_t ms);
+// Advances the clock as a flash write or erase would: only timer interrupts
+// registered with ESP_INTR_FLAG_IRAM run meanwhile, the rest fire late at the end
+void halFlashOperation(uint64_t us);
+
+// Tracing can be turned off so long benchmark runs don't grow the trace
+void halSetTraceEnabled(bool enabled);
+const std::vector<HalEvent>& halTrace();
+void halClearTrace();
+
+// Heap allocations (operator new, malloc, realloc, calloc) since the program
+// started, for checking that a code path allocates nothing
+uint64_t halAllocations();
+
+// Last value written to a GPIO pin or LEDC channel
+int halDigitalLevel(uint8_t pin);
+uint32_t halLedcDuty(uint8_t channel);
+
+#endif // HAL_SHIM_H
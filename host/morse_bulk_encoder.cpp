@@ -0,0 +1,268 @@
+#include "morse_bulk_encoder.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MORSE_BULK_X86 1
+#endif
+
+namespace {
+
+// Compact code index: MORSE_TABLE entries, then one slot for every unmapped byte
+const int CODE_COUNT = MORSE_TABLE_SIZE + 1;
+const uint8_t UNMAPPED_CODE = MORSE_TABLE_SIZE;
+
+// Every code plus its trailing separator is written as one 8-byte store
+const int SLOT_SIZE = 8;
+// Two adjacent codes with separators, written as one 16-byte store
+const int PAIR_SLOT_SIZE = 16;
+static_assert(2 * (MORSE_MAX_CODE_LENGTH + 1) <= PAIR_SLOT_SIZE, "Two Morse codes plus separators must fit a 16-byte slot");
+
+struct BulkSlots {
+    char text[CODE_COUNT][SLOT_SIZE];  // Code followed by ' ' padding
+    uint8_t advance[CODE_COUNT];       // Code length + 1
+};
+
+constexpr BulkSlots buildBulkSlots() {
+    BulkSlots slots{};
+    for (int i = 0; i < CODE_COUNT; i++) {
+        for (int j = 0; j < SLOT_SIZE; j++) {
+            slots.text[i][j] = ' ';
+        }
+        slots.advance[i] = 1;
+    }
+    for (int i = 0; i < MORSE_TABLE_SIZE; i++) {
+        const PackedCode code = MORSE_PACKED_TABLE.entry[i];
+        for (int j = 0; j < code.length; j++) {
+            slots.text[i][j] = MORSE_TABLE[i].code[j];
+        }
+        slots.advance[i] = static_cast<uint8_t>(code.length + 1);
+    }
+    return slots;
+}
+
+constexpr BulkSlots BULK_SLOTS = buildBulkSlots();
+
+// MORSE_ENCODE_INDEX with MORSE_UNMAPPED remapped to UNMAPPED_CODE
+struct CompactIndex {
+    uint8_t code[256];
+};
+
+constexpr CompactIndex buildCompactIndex() {
+    CompactIndex index{};
+    for (int c = 0; c < 256; c++) {
+        const uint8_t entry = MORSE_ENCODE_INDEX.entry[c];
+        index.code[c] = entry == MORSE_UNMAPPED ? UNMAPPED_CODE : entry;
+    }
+    return index;
+}
+
+constexpr CompactIndex COMPACT_INDEX = buildCompactIndex();
+
+struct PairSlots {
+    char text[CODE_COUNT * CODE_COUNT][PAIR_SLOT_SIZE];
+    uint8_t advance[CODE_COUNT * CODE_COUNT];
+};
+
+constexpr PairSlots buildPairSlots() {
+    PairSlots pairs{};
+    for (int a = 0; a < CODE_COUNT; a++) {
+        for (int b = 0; b < CODE_COUNT; b++) {
+            const int pair = a * CODE_COUNT + b;
+            const int advanceA = BULK_SLOTS.advance[a];
+            for (int j = 0; j < PAIR_SLOT_SIZE; j++) {
+                pairs.text[pair][j] = ' ';
+            }
+            for (int j = 0; j < advanceA; j++) {
+                pairs.text[pair][j] = BULK_SLOTS.text[a][j];
+            }
+            for (int j = 0; j < BULK_SLOTS.advance[b]; j++) {
+                pairs.text[pair][advanceA + j] = BULK_SLOTS.text[b][j];
+            }
+            pairs.advance[pair] = static_cast<uint8_t>(advanceA + BULK_SLOTS.advance[b]);
+        }
+    }
+    return pairs;
+}
+
+constexpr PairSlots PAIR_SLOTS = buildPairSlots();
+
+char* encodeScalar(const char* text, size_t length, char* cursor) {
+    for (size_t i = 0; i < length; i++) {
+        const uint8_t code = COMPACT_INDEX.code[static_cast<uint8_t>(text[i])];
+        memcpy(cursor, BULK_SLOTS.text[code], SLOT_SIZE);
+        cursor += BULK_SLOTS.advance[code];
+    }
+    return cursor;
+}
+
+#ifdef MORSE_BULK_X86
+
+// After case folding only ASCII bytes below 0x80 can map. Each high nibble that
+// holds at least one mapped byte gets a 16-entry pshufb table of compact code
+// indices, looked up by the low nibble.
+struct NibbleTables {
+    alignas(16) uint8_t lut[8][16];
+    uint8_t nibbles[8];
+    int count;
+};
+
+NibbleTables buildNibbleTables() {
+    NibbleTables tables{};
+    for (int hi = 0; hi < 8; hi++) {
+        bool used = false;
+        for (int lo = 0; lo < 16; lo++) {
+            const int c = hi * 16 + lo;
+            // Lowercase is folded before lookup, so those rows never need a table
+            const uint8_t code = (c >= 'a' && c <= 'z') ? UNMAPPED_CODE : COMPACT_INDEX.code[c];
+            tables.lut[tables.count][lo] = code;
+            used |= code != UNMAPPED_CODE;
+        }
+        if (used) {
+            tables.nibbles[tables.count++] = static_cast<uint8_t>(hi);
+        }
+    }
+    return tables;
+}
+
+const NibbleTables NIBBLE_TABLES = buildNibbleTables();
+
+// Emits codes two at a time from pair indices (first * CODE_COUNT + second)
+inline char* emitPairs(char* cursor, const uint16_t* pairs, int count) {
+    for (int j = 0; j < count; j++) {
+        memcpy(cursor, PAIR_SLOTS.text[pairs[j]], PAIR_SLOT_SIZE);
+        cursor += PAIR_SLOTS.advance[pairs[j]];
+    }
+    return cursor;
+}
+
+__attribute__((target("sse4.1")))
+char* encodeSse4(const char* text, size_t length, char* cursor) {
+    const __m128i lowerA = _mm_set1_epi8('a' - 1);
+    const __m128i lowerZ = _mm_set1_epi8('z' + 1);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+    const __m128i unmapped = _mm_set1_epi8(UNMAPPED_CODE);
+    const __m128i pairWeights = _mm_set1_epi16(static_cast<int16_t>(CODE_COUNT | (1 << 8)));
+
+    alignas(16) uint16_t pairs[8];
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+
+        // Case fold: clear 0x20 on 'a'..'z' (signed compares leave bytes >= 0x80 alone)
+        const __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(bytes, lowerA), _mm_cmplt_epi8(bytes, lowerZ));
+        bytes = _mm_andnot_si128(_mm_and_si128(isLower, caseBit), bytes);
+
+        // Classify by high nibble and look up by low nibble; bytes >= 0x80 match no nibble
+        const __m128i lo = _mm_and_si128(bytes, lowNibble);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibble);
+        __m128i index = unmapped;
+        for (int t = 0; t < NIBBLE_TABLES.count; t++) {
+            const __m128i lut = _mm_load_si128(reinterpret_cast<const __m128i*>(NIBBLE_TABLES.lut[t]));
+            const __m128i row = _mm_cmpeq_epi8(hi, _mm_set1_epi8(NIBBLE_TABLES.nibbles[t]));
+            index = _mm_blendv_epi8(index, _mm_shuffle_epi8(lut, lo), row);
+        }
+
+        // Adjacent indices (a, b) -> a * CODE_COUNT + b
+        _mm_store_si128(reinterpret_cast<__m128i*>(pairs), _mm_maddubs_epi16(index, pairWeights));
+        cursor = emitPairs(cursor, pairs, 8);
+    }
+    return encodeScalar(text + i, length - i, cursor);
+}
+
+__attribute__((target("avx2")))
+char* encodeAvx2(const char* text, size_t length, char* cursor) {
+    const __m256i lowerA = _mm256_set1_epi8('a' - 1);
+    const __m256i lowerZ = _mm256_set1_epi8('z' + 1);
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+    const __m256i unmapped = _mm256_set1_epi8(UNMAPPED_CODE);
+    const __m256i pairWeights = _mm256_set1_epi16(static_cast<int16_t>(CODE_COUNT | (1 << 8)));
+
+    alignas(32) uint16_t pairs[16];
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+
+        const __m256i isLower = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, lowerA), _mm256_cmpgt_epi8(lowerZ, bytes));
+        bytes = _mm256_andnot_si256(_mm256_and_si256(isLower, caseBit), bytes);
+
+        const __m256i lo = _mm256_and_si256(bytes, lowNibble);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), lowNibble);
+        __m256i index = unmapped;
+        for (int t = 0; t < NIBBLE_TABLES.count; t++) {
+            const __m256i lut = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(NIBBLE_TABLES.lut[t])));
+            const __m256i row = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(NIBBLE_TABLES.nibbles[t]));
+            index = _mm256_blendv_epi8(index, _mm256_shuffle_epi8(lut, lo), row);
+        }
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(pairs), _mm256_maddubs_epi16(index, pairWeights));
+        cursor = emitPairs(cursor, pairs, 16);
+    }
+    // The tail runs non-VEX SSE code
+    _mm256_zeroupper();
+    return encodeSse4(text + i, length - i, cursor);
+}
+
+#endif // MORSE_BULK_X86
+
+} // namespace
+
+BulkEncodeKernel bulkEncodeBestKernel() {
+#ifdef MORSE_BULK_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return BulkEncodeKernel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return BulkEncodeKernel::SSE4;
+    }
+#endif
+    return BulkEncodeKernel::SCALAR;
+}
+
+const char* bulkEncodeKernelName(BulkEncodeKernel kernel) {
+    switch (kernel) {
+        case BulkEncodeKernel::SCALAR:
+            return "scalar";
+        case BulkEncodeKernel::SSE4:
+            return "sse4";
+        case BulkEncodeKernel::AVX2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+size_t bulkEncodeCapacity(size_t length) {
+    return length * (MORSE_MAX_CODE_LENGTH + 1) + PAIR_SLOT_SIZE;
+}
+
+size_t bulkEncode(const char* text, size_t length, char* out) {
+    static const BulkEncodeKernel best = bulkEncodeBestKernel();
+    return bulkEncode(text, length, out, best);
+}
+
+size_t bulkEncode(const char* text, size_t length, char* out, BulkEncodeKernel kernel) {
+    if (length == 0) {
+        return 0;
+    }
+
+    char* end;
+    switch (kernel) {
+#ifdef MORSE_BULK_X86
+        case BulkEncodeKernel::AVX2:
+            end = encodeAvx2(text, length, out);
+            break;
+        case BulkEncodeKernel::SSE4:
+            end = encodeSse4(text, length, out);
+            break;
+#endif
+        default:
+            end = encodeScalar(text, length, out);
+            break;
+    }
+
+    // Drop the separator written after the last code
+    return (end - out) - 1;
+}
@@ -0,0 +1,30 @@
+#ifndef MORSE_BULK_ENCODER_H
+#define MORSE_BULK_ENCODER_H
+
+#include <stddef.h>
+#include "morse_code.h"
+
+// Host-side bulk text -> ASCII Morse encoder for offline corpus conversion.
+// Output matches encodeMorse and text_to_morse.py: one code per input byte,
+// joined by single spaces, with unmapped bytes contributing an empty code. Only
+// ASCII is encoded: bytes from 0x80 up are unmapped here, where encodeMorse
+// decodes them as UTF-8.
+
+enum class BulkEncodeKernel {
+    SCALAR,
+    SSE4,
+    AVX2
+};
+
+// Widest kernel this CPU supports
+BulkEncodeKernel bulkEncodeBestKernel();
+const char* bulkEncodeKernelName(BulkEncodeKernel kernel);
+
+// Bytes out must provide for a length-byte input, including write slack
+size_t bulkEncodeCapacity(size_t length);
+
+// Encodes text[0..length) into out and returns the encoded length. Not NUL-terminated.
+size_t bulkEncode(const char* text, size_t length, char* out);
+size_t bulkEncode(const char* text, size_t length, char* out, BulkEncodeKernel kernel);
+
+#endif // MORSE_BULK_ENCODER_H
@@ -0,0 +1,42 @@
+// Offline corpus converter: encodes each line of stdin to ASCII Morse on stdout,
+// with the same output as text_to_morse.py.
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -I include -I host host/morse_corpus.cpp host/morse_bulk_encoder.cpp -o morse_corpus
+//   ./morse_corpus < messages.txt > messages.morse
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "morse_bulk_encoder.h"
+
+int main() {
+    std::vector<char> input;
+    char chunk[1 << 16];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+        input.insert(input.end(), chunk, chunk + read);
+    }
+
+    std::vector<char> output;
+    size_t start = 0;
+    while (start < input.size()) {
+        const char* newline = static_cast<const char*>(memchr(input.data() + start, '\n', input.size() - start));
+        const size_t end = newline ? newline - input.data() : input.size();
+        size_t length = end - start;
+        if (length > 0 && input[start + length - 1] == '\r') {
+            length--;
+        }
+
+        if (output.size() < bulkEncodeCapacity(length) + 1) {
+            output.resize(bulkEncodeCapacity(length) + 1);
+        }
+        const size_t encoded = bulkEncode(input.data() + start, length, output.data());
+        output[encoded] = '\n';
+        fwrite(output.data(), 1, encoded + 1, stdout);
+
+        start = end + 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#ifndef ECHO_CACHE_H
+#define ECHO_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "morse_code.h"
+#include "packed_morse.h"
+
+// Message echoes kept; the least recently used one makes room for a new message
+#ifndef MORSE_ECHO_CACHE_SIZE
+#define MORSE_ECHO_CACHE_SIZE 8
+#endif
+
+// Longest echo kept, in symbols; longer messages are encoded every time
+#ifndef MORSE_ECHO_CACHE_SYMBOLS
+#define MORSE_ECHO_CACHE_SYMBOLS 256
+#endif
+
+// Longest message text kept with its echo, in bytes; longer messages are encoded
+// every time. Matches a Text Input write.
+#ifndef MORSE_ECHO_CACHE_TEXT
+#define MORSE_ECHO_CACHE_TEXT 100
+#endif
+
+// Compiled echo of one message text: its symbols in PackedMorse layout
+struct CachedEcho {
+    uint32_t hash;  // echoCacheHash() of the text
+    uint16_t textLength;
+    MorseAlphabet alphabet;
+    bool truncated;  // The echo stopped short of the text
+    bool sent;       // Sent in full since EchoCache::forgetSent()
+    bool overflow;   // More text or symbols than fit; never stored
+    uint16_t symbolCount;
+    uint32_t crc;       // packedMorseCrc32() of the symbols
+    uint32_t lastUsed;  // 0 while empty or being filled
+    uint8_t packed[MORSE_ECHO_CACHE_SYMBOLS / 4];
+    uint8_t text[MORSE_ECHO_CACHE_TEXT];  // textLength bytes, compared on every hash match
+
+    void add(MorseSymbol symbol);
+    void assign(const PackedMorse& morse);
+    MorseSymbol at(size_t index) const;
+};
+
+// FNV-1a over the alphabet and the text bytes; the cache key
+uint32_t echoCacheHash(const uint8_t* data, size_t length, MorseAlphabet alphabet);
+
+// Small LRU of message echoes keyed by text hash, so a message sent again skips
+// encoding. Entries keep their text: a hit needs the same alphabet and the same
+// bytes, so two texts whose hashes collide never get each other's echo. Used from
+// the BLE task only.
+class EchoCache {
+private:
+    CachedEcho entries[MORSE_ECHO_CACHE_SIZE] = {};
+    CachedEcho scratch = {};  // Filled between claim() and commit()
+    uint32_t useClock = 0;
+    uint32_t hitCount = 0;
+    uint32_t missCount = 0;
+    uint32_t evictionCount = 0;
+
+public:
+    static const size_t SIZE = MORSE_ECHO_CACHE_SIZE;
+    static const size_t MAX_SYMBOLS = MORSE_ECHO_CACHE_SYMBOLS;
+    static const size_t MAX_TEXT = MORSE_ECHO_CACHE_TEXT;
+
+    // Counts a hit or a miss; nullptr on a miss
+    CachedEcho* find(uint32_t hash, const uint8_t* data, size_t length, MorseAlphabet alphabet);
+
+    // Empty scratch entry for a message that missed, holding a copy of its text.
+    // Fill it with add()/assign(), then commit() it to copy it over the least
+    // recently used entry and make it findable.
+    CachedEcho& claim(uint32_t hash, const uint8_t* data, size_t length, MorseAlphabet alphabet);
+    // The stored entry; nullptr, with nothing evicted, if the text or echo overflowed
+    const CachedEcho* commit(const CachedEcho& echo, bool truncated);
+
+    void forgetSent();  // New connection or echo format: the central may have none of them
+    void clear();
+
+    uint32_t hits() const;
+    uint32_t misses() const;
+    uint32_t evictions() const;  // Stored echoes pushed out by a newer message
+    size_t size() const;         // Stored echoes
+};
+
+#endif // ECHO_CACHE_H
@@ -0,0 +1,78 @@
+#ifndef MESSAGE_INGEST_H
+#define MESSAGE_INGEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "echo_cache.h"
+#include "morse_converter.h"
+#include "morse_echo.h"
+
+// Status codes - must match Flutter app
+enum DeviceStatus {
+    IDLE = 0,
+    PROCESSING = 1,
+    PLAYING = 2,
+    ERROR = 3,
+    QUEUE_FULL = 4  // Write rejected; the app should retry once playback drains
+};
+
+// Reports a status change; the device writes the status characteristic and wakes
+// the playback task from here
+typedef void (*DeviceStatusSink)(DeviceStatus status, void* context);
+
+// What happens to a complete message written over BLE, whether in one Text Input
+// write or reassembled from a framed transfer: its echo goes back in the format this
+// connection negotiated (from the echo cache when it was sent recently) and the text
+// is queued for playback. Nothing here touches BLE or the heap; the echo leaves
+// through echoSink and status changes through statusSink, so the host build runs
+// exactly this code. BLE task only.
+class MessageIngest {
+private:
+    MorseConverter& morse;
+    EchoChunkSink echoSink;
+    void* echoContext;
+    DeviceStatusSink statusSink;
+    void* statusContext;
+
+    // Echo format for this connection; apps that never negotiate one get ASCII
+    EchoFormat format = EchoFormat::ASCII;
+    bool streamed = false;
+    size_t chunkSize = ECHO_DEFAULT_CHUNK;
+    bool cacheAware = false;
+    uint8_t echoBuffer[packedEchoSize(PackedMorse::CAPACITY)];
+    EchoStreamer streamer;
+
+    // Echoes of recent messages; a cache-aware connection gets only the digest of
+    // one it was already sent
+    EchoCache cache;
+
+    void reportStatus(DeviceStatus status);
+    bool sendPackedEcho(const PackedMorse& packed, bool truncated);
+    bool sendEncodedEcho(const uint8_t* data, size_t length, CachedEcho& cached);
+    bool sendCachedEcho(const CachedEcho& cached);
+
+public:
+    MessageIngest(MorseConverter& morse, EchoChunkSink echoSink, void* echoContext, DeviceStatusSink statusSink,
+                  void* statusContext);
+
+    // Echoes a complete message and queues it for playback. Returns PLAYING when it
+    // was queued, otherwise the error status that was reported. transfer: data is the
+    // transfer buffer, which may be longer than a queue slot and is played in place.
+    DeviceStatus accept(const uint8_t* data, size_t length, bool transfer = false);
+
+    // Sends the echo in the negotiated format; false if the text has no Morse or the
+    // echo could not be sent. Messages sent recently skip the encoder.
+    bool sendEcho(const uint8_t* data, size_t length);
+
+    // chunkSize is clamped to ECHO_MIN_CHUNK..ECHO_MAX_CHUNK; every cached echo
+    // counts as unsent from here on
+    void setEchoFormat(EchoFormat format, bool streamed = false, size_t chunkSize = ECHO_DEFAULT_CHUNK,
+                       bool cacheAware = false);
+    EchoFormat echoFormat() const;
+    bool isEchoStreamed() const;
+    size_t echoChunkSize() const;
+    bool isCacheAware() const;
+    const EchoCache& echoCache() const;
+};
+
+#endif // MESSAGE_INGEST_H
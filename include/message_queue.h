@@ -0,0 +1,71 @@
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "morse_code.h"
+#include "morse_timeline.h"
+
+// Messages that can wait behind the one being played
+#ifndef MORSE_QUEUE_DEPTH
+#define MORSE_QUEUE_DEPTH 4
+#endif
+
+// Longest message text a queue slot holds; a longer framed transfer is played from
+// the transfer buffer instead (pushBorrowed)
+#ifndef MORSE_MESSAGE_MAX
+#define MORSE_MESSAGE_MAX 100
+#endif
+
+// Longest compiled message (a preset) a queue slot holds, in symbols
+#ifndef MORSE_QUEUE_SYMBOLS
+#define MORSE_QUEUE_SYMBOLS 512
+#endif
+
+const size_t QUEUE_SLOT_BYTES = MORSE_MESSAGE_MAX + 1 > MORSE_QUEUE_SYMBOLS / 4 ? MORSE_MESSAGE_MAX + 1
+                                                                               : MORSE_QUEUE_SYMBOLS / 4;
+
+struct QueuedMessage {
+    uint16_t length;         // Bytes of text, or symbols when packed
+    MorseAlphabet alphabet;  // Selected when the message arrived, so its echo and playback agree
+    bool packed;             // source holds symbols in PackedMorse layout (a preset), not text
+    TimelineLength timelineLength;  // Counted by the producer, so playback never scans the text
+    const char* source;      // text, or the producer's buffer for a borrowed message
+    char text[QUEUE_SLOT_BYTES];  // NUL-terminated copy of the written bytes, or packed symbols
+};
+
+// Lock-free single-producer/single-consumer ring of message texts. The producer
+// (BLE write handler) only advances tail; the consumer (playback engine) reads slots
+// in place and only advances head once it has finished with them.
+class MessageQueue {
+private:
+    QueuedMessage slots[MORSE_QUEUE_DEPTH];
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+
+public:
+    static const size_t DEPTH = MORSE_QUEUE_DEPTH;
+    static const size_t MAX_LENGTH = MORSE_MESSAGE_MAX;
+    static const size_t MAX_SYMBOLS = MORSE_QUEUE_SYMBOLS;
+
+    // Producer side; false when full. Text beyond MAX_LENGTH is cut off, so
+    // timelineLength must be counted over the first MAX_LENGTH bytes.
+    bool push(const uint8_t* data, size_t length, MorseAlphabet alphabet, const TimelineLength& timelineLength);
+    // Producer side, compiled symbols (a preset); false when full or over MAX_SYMBOLS symbols
+    bool pushPacked(const uint8_t* symbols, size_t symbolCount, const TimelineLength& timelineLength);
+    // Producer side, text of any length played from data in place; the producer must
+    // leave data untouched while holds(data)
+    bool pushBorrowed(const uint8_t* data, size_t length, MorseAlphabet alphabet, const TimelineLength& timelineLength);
+    bool holds(const void* data) const;  // Producer side; a queued message, or the one playing, borrows data
+
+    // Consumer side
+    const QueuedMessage* front() const;  // nullptr when empty
+    void pop();
+
+    size_t size() const;
+    bool isEmpty() const;
+    bool isFull() const;
+};
+
+#endif // MESSAGE_QUEUE_H
@@ -0,0 +1,81 @@
+#ifndef MESSAGE_TRANSFER_H
+#define MESSAGE_TRANSFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Framed transfer of messages larger than one BLE write. The sender splits the text
+// into fixed-size chunks and writes them without response; the receiver reassembles
+// them in place and acknowledges cumulatively, so the sender can keep a window of
+// frames in flight.
+//
+// Frame:  [type][transfer id][sequence lo][sequence hi][payload...]
+//   START: payload = [total length u16][chunk size u16][window], sequence 0
+//   DATA:  payload = chunk `sequence`, chunkSize bytes (the last may be shorter)
+//   ABORT: no payload
+// Ack:    [transfer id][TransferStatus][next expected sequence u16]
+//
+// Acks go out on START, every window/2 in-order chunks, on every out-of-order or
+// duplicate chunk (so the sender can resend from nextSequence) and on completion.
+
+// Largest reassembled message; it plays from the reassembly buffer, so this is sized
+// apart from the queue slots (MORSE_MESSAGE_MAX)
+#ifndef MORSE_TRANSFER_MAX
+#define MORSE_TRANSFER_MAX 4096
+#endif
+
+const uint8_t TRANSFER_START = 0x01;
+const uint8_t TRANSFER_DATA = 0x02;
+const uint8_t TRANSFER_ABORT = 0x03;
+
+const size_t TRANSFER_HEADER_SIZE = 4;
+const size_t TRANSFER_ACK_SIZE = 4;
+const uint16_t TRANSFER_MIN_CHUNK = 16;
+const uint16_t TRANSFER_MAX_CHUNK = 512 - TRANSFER_HEADER_SIZE;  // Largest ATT value
+const uint16_t TRANSFER_MAX_CHUNKS = (MORSE_TRANSFER_MAX + TRANSFER_MIN_CHUNK - 1) / TRANSFER_MIN_CHUNK;
+
+enum class TransferStatus : uint8_t {
+    IN_PROGRESS = 0,
+    COMPLETE = 1,
+    TOO_LARGE = 2,    // START rejected: length or chunk size out of range
+    NO_TRANSFER = 3,  // DATA for a transfer that is not open
+    QUEUE_FULL = 4,   // Reassembled, but there was no room to play it; resend later
+    ABORTED = 5,
+    BUSY = 6          // START rejected: the last message is still playing from the buffer; retry later
+};
+
+struct TransferAck {
+    uint8_t transferId;
+    TransferStatus status;
+    uint16_t nextSequence;  // All chunks below this have arrived
+
+    void encode(uint8_t* out) const;  // TRANSFER_ACK_SIZE bytes
+};
+
+class TransferReceiver {
+private:
+    uint8_t buffer[MORSE_TRANSFER_MAX];
+    uint8_t receivedChunks[(TRANSFER_MAX_CHUNKS + 7) / 8];
+    bool open = false;
+    uint8_t transferId = 0;
+    uint16_t totalLength = 0;
+    uint16_t chunkSize = 0;
+    uint16_t chunkCount = 0;
+    uint16_t nextSequence = 0;  // First chunk not yet received
+    uint16_t ackEvery = 1;      // In-order chunks per ack
+    uint16_t sinceAck = 0;
+    TransferStatus completion = TransferStatus::COMPLETE;  // Re-sent for late duplicates
+
+    bool hasChunk(uint16_t sequence) const;
+
+public:
+    void reset();
+    // Handles one frame; returns true when ack should be sent back
+    bool receive(const uint8_t* frame, size_t length, TransferAck& ack);
+    bool isComplete() const;
+    void setCompletionStatus(TransferStatus status);  // E.g. QUEUE_FULL when the message could not be taken
+    const uint8_t* data() const;  // Reassembled message once complete
+    size_t length() const;
+};
+
+#endif // MESSAGE_TRANSFER_H
@@ -0,0 +1,87 @@
+// Generated by scripts/gen_morse_tables.py from morse_alphabet.csv; edit the CSV, not this file.
+// Included from morse_code.h. Everything here is constant data, so on the ESP32 it
+// stays in flash, and inline constexpr keeps one copy however many files use it.
+#pragma once
+
+// Prosigns, sent and decoded as control bytes: <KA> = '\x02', <SK> = '\x04', <SN> = '\x06'
+
+constexpr int MORSE_TABLE_SIZE = 57;
+inline constexpr MorseEntry MORSE_TABLE[MORSE_TABLE_SIZE] = {
+    {'A', ".-"},        {'B', "-..."},      {'C', "-.-."},      {'D', "-.."},       {'E', "."},
+    {'F', "..-."},      {'G', "--."},       {'H', "...."},      {'I', ".."},        {'J', ".---"},
+    {'K', "-.-"},       {'L', ".-.."},      {'M', "--"},        {'N', "-."},        {'O', "---"},
+    {'P', ".--."},      {'Q', "--.-"},      {'R', ".-."},       {'S', "..."},       {'T', "-"},
+    {'U', "..-"},       {'V', "...-"},      {'W', ".--"},       {'X', "-..-"},      {'Y', "-.--"},
+    {'Z', "--.."},      {'1', ".----"},     {'2', "..---"},     {'3', "...--"},     {'4', "....-"},
+    {'5', "....."},     {'6', "-...."},     {'7', "--..."},     {'8', "---.."},     {'9', "----."},
+    {'0', "-----"},     {'.', ".-.-.-"},    {',', "--..--"},    {'?', "..--.."},    {'\'', ".----."},
+    {'!', "-.-.--"},    {'/', "-..-."},     {'(', "-.--."},     {')', "-.--.-"},    {'&', ".-..."},
+    {':', "---..."},    {';', "-.-.-."},    {'=', "-...-"},     {'+', ".-.-."},     {'-', "-....-"},
+    {'_', "..--.-"},    {'"', ".-..-."},    {'$', "...-..-"},   {'@', ".--.-."},    {'\x02', "-.-.-"},
+    {'\x04', "...-.-"}, {'\x06', "...-."}
+};
+
+constexpr int MORSE_MAX_CODE_LENGTH = 7;
+
+struct MorsePackedTable {
+    PackedCode entry[MORSE_TABLE_SIZE];
+};
+
+// Parallel to MORSE_TABLE, indexed through MORSE_ENCODE_INDEX
+inline constexpr MorsePackedTable MORSE_PACKED_TABLE = {{
+    {2, 0x02}, {4, 0x01}, {4, 0x05}, {3, 0x01}, {1, 0x00}, {4, 0x04}, {3, 0x03}, {4, 0x00},
+    {2, 0x00}, {4, 0x0e}, {3, 0x05}, {4, 0x02}, {2, 0x03}, {2, 0x01}, {3, 0x07}, {4, 0x06},
+    {4, 0x0b}, {3, 0x02}, {3, 0x00}, {1, 0x01}, {3, 0x04}, {4, 0x08}, {3, 0x06}, {4, 0x09},
+    {4, 0x0d}, {4, 0x03}, {5, 0x1e}, {5, 0x1c}, {5, 0x18}, {5, 0x10}, {5, 0x00}, {5, 0x01},
+    {5, 0x03}, {5, 0x07}, {5, 0x0f}, {5, 0x1f}, {6, 0x2a}, {6, 0x33}, {6, 0x0c}, {6, 0x1e},
+    {6, 0x35}, {5, 0x09}, {5, 0x0d}, {6, 0x2d}, {5, 0x02}, {6, 0x07}, {6, 0x15}, {5, 0x11},
+    {5, 0x0a}, {6, 0x21}, {6, 0x2c}, {6, 0x12}, {7, 0x48}, {6, 0x16}, {5, 0x15}, {6, 0x28},
+    {5, 0x08}
+}};
+
+// Direct byte -> MORSE_TABLE index lookup, lowercase letters fold onto uppercase
+inline constexpr MorseEncodeIndex MORSE_ENCODE_INDEX = {{
+    0xff, 0xff, 0x36, 0xff, 0x37, 0xff, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x28, 0x33, 0xff, 0x34, 0xff, 0x2c, 0x27, 0x2a, 0x2b, 0xff, 0x30, 0x25, 0x31, 0x24, 0x29,
+    0x23, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x2d, 0x2e, 0xff, 0x2f, 0xff, 0x26,
+    0x35, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0x32,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+}};
+
+// Dichotomic decode tree in implicit array layout: root at 1, dot -> 2n, dash -> 2n + 1.
+// Nodes without a character hold 0.
+constexpr int MORSE_DECODE_TREE_SIZE = 2 << MORSE_MAX_CODE_LENGTH;
+
+struct MorseDecodeTree {
+    char node[MORSE_DECODE_TREE_SIZE];
+};
+
+inline constexpr MorseDecodeTree MORSE_DECODE_TREE = {{
+    0, 0, 'E', 'T', 'I', 'A', 'N', 'M', 'S', 'U', 'R', 'W', 'D', 'K', 'G', 'O',
+    'H', 'V', 'F', 0, 'L', 0, 'P', 'J', 'B', 'X', 'C', 'Y', 'Z', 'Q', 0, 0,
+    '5', '4', '\x06', '3', 0, 0, 0, '2', '&', 0, '+', 0, 0, 0, 0, '1',
+    '6', '=', '/', 0, 0, '\x02', '(', 0, '7', 0, 0, 0, '8', 0, '9', '0',
+    0, 0, 0, 0, 0, '\x04', 0, 0, 0, 0, 0, 0, '?', '_', 0, 0,
+    0, 0, '"', 0, 0, '.', 0, 0, 0, 0, '@', 0, 0, 0, '\'', 0,
+    0, '-', 0, 0, 0, 0, 0, 0, 0, 0, ';', '!', 0, ')', 0, 0,
+    0, 0, 0, ',', 0, 0, 0, 0, ':', 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, '$', 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+}};
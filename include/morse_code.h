@@ -1,71 +1,95 @@
 #pragma once
 
-#include <Arduino.h>
+#include <stdint.h>
 
-// Morse code lookup table
+// Morse code lookup table entry
 struct MorseEntry {
     char character;
     const char* code;
 };
 
-const int MORSE_TABLE_SIZE = 36;
-const MorseEntry MORSE_TABLE[MORSE_TABLE_SIZE] = {
-    {'A', ".-"},     {'B', "-..."},   {'C', "-.-."},   {'D', "-.."},    {'E', "."},
-    {'F', "..-."},   {'G', "--."},    {'H', "...."},   {'I', ".."},     {'J', ".---"},
-    {'K', "-.-"},    {'L', ".-.."},   {'M', "--"},     {'N', "-."},     {'O', "---"},
-    {'P', ".--."},   {'Q', "--.-"},   {'R', ".-."},    {'S', "..."},    {'T', "-"},
-    {'U', "..-"},    {'V', "...-"},   {'W', ".--"},    {'X', "-..-"},   {'Y', "-.--"},
-    {'Z', "--.."},   {'0', "-----"},  {'1', ".----"},  {'2', "..---"},  {'3', "...--"},
-    {'4', "....-"},  {'5', "....."},  {'6', "-...."},  {'7', "--..."},  {'8', "---.."},
-    {'9', "----."}
+// Marks a byte with no Morse mapping in MORSE_ENCODE_INDEX
+constexpr uint8_t MORSE_UNMAPPED = 0xFF;
+
+// Direct byte -> MORSE_TABLE index lookup
+struct MorseEncodeIndex {
+    uint8_t entry[256];
+};
+
+// Bit-packed form of a MORSE_TABLE code: bit i (LSB first) set means symbol i is a dash
+struct PackedCode {
+    uint8_t length;
+    uint8_t bits;
+};
+
+// Alphabets for non-ASCII text; ASCII always goes through MORSE_TABLE. Their codes
+// overlap (Cyrillic Я and Latin Ä are both .-.-), so one is selected per message
+// and the listener has to know which.
+enum class MorseAlphabet : uint8_t {
+    LATIN,     // Accented Latin letters, own codes or transliterated to the base letter
+    CYRILLIC,
+    GREEK,
+    WABUN      // Japanese kana, voiced kana as two letters
 };
 
-// // Morse code alphabet stored in flash memory
-// const MorseMapping MORSE_TABLE[] = {
-//     {'A', ".-"},
-//     {'B', "-..."},
-//     {'C', "-.-."},
-//     {'D', "-.."},
-//     {'E', "."},
-//     {'F', "..-."},
-//     {'G', "--."},
-//     {'H', "...."},
-//     {'I', ".."},
-//     {'J', ".---"},
-//     {'K', "-.-"},
-//     {'L', ".-.."},
-//     {'M', "--"},
-//     {'N', "-."},
-//     {'O', "---"},
-//     {'P', ".--."},
-//     {'Q', "--.-"},
-//     {'R', ".-."},
-//     {'S', "..."},
-//     {'T', "-"},
-//     {'U', "..-"},
-//     {'V', "...-"},
-//     {'W', ".--"},
-//     {'X', "-..-"},
-//     {'Y', "-.--"},
-//     {'Z', "--.."},
-//     {'0', "-----"},
-//     {'1', ".----"},
-//     {'2', "..---"},
-//     {'3', "...--"},
-//     {'4', "....-"},
-//     {'5', "....."},
-//     {'6', "-...."},
-//     {'7', "--..."},
-//     {'8', "---.."},
-//     {'9', "----."},
-//     {' ', " "},
-//     {'.', ".-.-.-"},
-//     {',', "--..--"},
-//     {'?', "..--.."},
-//     {'!', "-.-.--"},
-//     {'/', "-..-."},
-//     {'@', ".--.-."},
-//     {'&', ".-..."}
-// };
-
-// const int MORSE_TABLE_SIZE = sizeof(MORSE_TABLE) / sizeof(MorseMapping); 
\ No newline at end of file
+constexpr uint8_t MORSE_ALPHABET_COUNT = 4;
+
+// Letters sent for one non-ASCII code point; unused ones have length 0
+constexpr int MORSE_GLYPH_LETTERS = 2;
+
+struct MorseGlyphEntry {
+    MorseAlphabet alphabet;
+    PackedCode letters[MORSE_GLYPH_LETTERS];
+};
+
+// MORSE_TABLE, MORSE_ENCODE_INDEX, MORSE_PACKED_TABLE and MORSE_DECODE_TREE, generated
+// from morse_alphabet.csv by scripts/gen_morse_tables.py before each build
+#include "morse_alphabet.h"
+
+static_assert(MORSE_TABLE_SIZE < MORSE_UNMAPPED, "MORSE_TABLE too large for 8-bit index");
+static_assert(MORSE_MAX_CODE_LENGTH <= 8, "PackedCode holds at most 8 symbols");
+
+constexpr PackedCode packMorseCode(const char* code) {
+    PackedCode packed{0, 0};
+    for (; code[packed.length] != '\0'; packed.length++) {
+        if (code[packed.length] == '-') {
+            packed.bits |= static_cast<uint8_t>(1u << packed.length);
+        }
+    }
+    return packed;
+}
+
+// Cross-checks the generated tables against each other, so a hand edit to the
+// header fails the build instead of encoding and decoding differently
+constexpr bool morseTablesAgree() {
+    for (int i = 0; i < MORSE_TABLE_SIZE; i++) {
+        const PackedCode code = packMorseCode(MORSE_TABLE[i].code);
+        const PackedCode packed = MORSE_PACKED_TABLE.entry[i];
+        const uint8_t c = static_cast<uint8_t>(MORSE_TABLE[i].character);
+        if (code.length != packed.length || code.bits != packed.bits || MORSE_ENCODE_INDEX.entry[c] != i) {
+            return false;
+        }
+        int node = 1;
+        for (int j = 0; j < code.length; j++) {
+            node = 2 * node + ((code.bits >> j) & 1);
+        }
+        if (MORSE_DECODE_TREE.node[node] != MORSE_TABLE[i].character) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(morseTablesAgree(), "morse_alphabet.h is inconsistent; regenerate it from morse_alphabet.csv");
+
+// Returns the dot/dash string for c, or nullptr if c has no Morse mapping
+inline const char* morseCodeFor(char c) {
+    const uint8_t index = MORSE_ENCODE_INDEX.entry[static_cast<uint8_t>(c)];
+    return index == MORSE_UNMAPPED ? nullptr : MORSE_TABLE[index].code;
+}
+
+// Packed code for c, with length 0 if c has no Morse mapping
+inline PackedCode packedCodeFor(char c) {
+    const uint8_t index = MORSE_ENCODE_INDEX.entry[static_cast<uint8_t>(c)];
+    return index == MORSE_UNMAPPED ? PackedCode{0, 0} : MORSE_PACKED_TABLE.entry[index];
+}
@@ -2,7 +2,14 @@
 #define MORSE_CONVERTER_H
 
 #include <Arduino.h>
+#include <atomic>
 #include "morse_code.h"
+#include "morse_encoder.h"
+#include "message_queue.h"
+#include "morse_timeline.h"
+#include "packed_morse.h"
+#include "playback_progress.h"
+#include "status_pattern.h"
 
 // Output mode configuration
 enum class OutputMode {
@@ -13,25 +20,51 @@ enum class OutputMode {
 
 #define LED_PIN 21  // Orange user LED 
 
+// ASCII Morse buffer behind textToMorse() and packedToAscii(); longer output is truncated
+#ifndef MORSE_ASCII_BUFFER
+#define MORSE_ASCII_BUFFER 256
+#endif
+
+// Playback backend, chosen at build time:
+//   MORSE_PLAYBACK_TIMER defined - edges are driven from a hardware timer ISR at microsecond deadlines
+//   otherwise                   - edges are driven by polling updatePlayback() from loop()
+#ifdef MORSE_PLAYBACK_TIMER
+#define MORSE_PLAYBACK_BACKEND "timer"
+#else
+#define MORSE_PLAYBACK_BACKEND "polled"
+#endif
+
+// Edge timing of the current/last message, collected when built with MORSE_JITTER_PROBE
+struct PlaybackJitterStats {
+    uint32_t edges;
+    uint32_t maxLatenessUs;       // Worst edge delay against the ideal schedule
+    uint64_t totalLatenessUs;
+    uint32_t maxIntervalErrorUs;  // Worst deviation of one interval from its nominal duration
+};
+
 // Morse playback states
 enum class PlaybackState {
     IDLE,
     SYMBOL_ON,
-    SYMBOL_OFF,
-    LETTER_SPACE
+    SYMBOL_OFF
 };
 
 class MorseConverter {
 private:
     // Buffer for storing morse code strings
-    char morseBuffer[256];
+    char morseBuffer[MORSE_ASCII_BUFFER];
+    // Packed symbol stream for textToPackedMorse and ASCII playback
+    PackedMorse packedBuffer;
+    bool truncated = false;  // Last encode did not fit its buffer
+    MorseAlphabet alphabet = MorseAlphabet::LATIN;  // For text encoded or queued from now on
     
-    // Timing constants (in milliseconds)
-    static const int DOT_DURATION = 100;
-    static const int DASH_DURATION = DOT_DURATION * 3;
-    static const int SYMBOL_SPACE = DOT_DURATION;
-    static const int LETTER_SPACE = DOT_DURATION * 3;
-    static const int WORD_SPACE = DOT_DURATION * 7;
+    // Speed of the events being scheduled; element and gap lengths in units are in morse_timeline.h.
+    // A new speed is posted to requestedTiming (wpm << 8 | farnsworthWpm), worked out by the
+    // playback task into pendingTiming and taken up at the next edge.
+    MorseTiming timing = makeMorseTiming(DEFAULT_WPM);
+    std::atomic<uint16_t> requestedTiming{0};
+    MorseTiming pendingTiming = timing;
+    bool timingPending = false;
     
     // PWM configuration
     static const int pwmFreq = 5000;
@@ -45,38 +78,131 @@ private:
     
     // Playback state
     PlaybackState playbackState = PlaybackState::IDLE;
-    const char* currentMorse = nullptr;
-    int currentPosition = 0;
-    unsigned long lastStateChange = 0;
-    unsigned long currentDuration = 0;
-    bool isPlaying = false;
+    const uint8_t* packedSymbols = nullptr;  // Packed source (PackedMorse layout), or nullptr when playing from textEncoder
+    size_t packedLength = 0;
+    MorseStreamEncoder textEncoder;
+    MessageQueue messageQueue;
+    const QueuedMessage* queuedMessage = nullptr;  // Queue slot textEncoder is reading, if any
+    void (*wakeHandler)(void* context) = nullptr;
+    void* wakeContext = nullptr;
+    bool playingQueue = false;  // Chain queued messages when the current one runs out
+    int currentPosition = 0;  // Symbols compiled so far
+    bool playbackOpen = false;  // Playback task side: a message is compiling or playing, until finishPlayback()
+    bool sourceDone = false;    // Everything to play is in the timeline; the edge ends playback when it drains
+    bool starved = false;       // The edge found the timeline empty before sourceDone; updatePlayback() resumes it
+    MorseTimeline timeline;
+    TimelineLength messageLength;  // Whole message, including queued messages chained so far
+    TimelineLength playedLength;   // Events already finished
+    TimelineEvent currentEvent = 0;  // Event being played, 0 before the first
+    uint32_t currentEventUs = 0;     // Its scheduled duration
+    uint64_t playedUs = 0;           // Time spent on finished events, at the speeds they were played at
+    uint64_t lastMessageUs = 0;      // Effective duration of the last finished message
+    uint64_t nextDeadlineUs = 0; // Absolute time of the next edge (micros(), or timer count)
+    volatile bool isPlaying = false;
+
+    // Each mark is compiled with the progress to publish as it starts, so progress
+    // follows what is heard rather than the encoder running ahead of it
+    bool letterPending = true;   // Next mark compiled starts a letter
+    uint8_t messageIndex = 0;    // Chained messages begun since playback started
+    uint16_t packedLetters = 0;  // Letters compiled from packedSymbols
+    PlaybackProgress compiledProgress = {};  // Of the last mark compiled
+    std::atomic<uint32_t> publishedProgress{PlaybackProgress().pack()};
+
+    // Status LED / haptic preview; requested from any task, played by updatePlayback() while idle
+    StatusSequencer statusSequencer;
+    std::atomic<uint8_t> requestedPattern{static_cast<uint8_t>(StatusPattern::NONE)};
+
+#ifdef MORSE_PLAYBACK_TIMER
+    bool timerReady = false;
+    // An IRAM interrupt: it only pops the next compiled event and writes the pins, so
+    // it keeps time while flash is written (e.g. saving a preset)
+    static bool onPlaybackTimer(void* arg);
+    void resumeIfStarved();
+#endif
+
+#ifdef MORSE_JITTER_PROBE
+    PlaybackJitterStats jitterStats = {};
+    unsigned long idealEdgeUs = 0;
+    uint32_t lastLatenessUs = 0;
+    void recordEdge();
+#endif
     
     // Private methods
-    const char* findMorseCode(char c);
+    const char* findMorseCode(char c);  // nullptr if c is unmapped
     void setupPWM();
     void updateOutputs(bool state, uint8_t intensity);
+    void driveOutputs(bool level);
+    void requestPattern(StatusPattern pattern);
+    void applyPatternStep(const PatternStep& step);
+    void updateStatusPattern();
+    void beginPlayback();
+    bool nextSymbol(MorseSymbol& symbol);
+    TimelineLength countMessageLength() const;
+    void postRequestedTiming();
+    void closeSource();
+    bool reopenSource();
+    bool chainQueuedMessage();
+    void compileSymbol(MorseSymbol symbol);
+    void refillTimeline();
+    bool advancePlayback();
+    void finishPlayback();
 
 public:
     explicit MorseConverter(uint8_t vib_pin, OutputMode mode = OutputMode::LED_ONLY);
     uint8_t getVibrationPin() const;
     void setOutputMode(OutputMode mode);
     OutputMode getOutputMode() const;
+    void setAlphabet(MorseAlphabet alphabet);  // Producer side; messages already queued keep theirs
+    MorseAlphabet getAlphabet() const;
+    size_t encodedLength(const char* text) const;  // strlen of textToMorse(text) without truncation
     const char* textToMorse(const char* text);
+    const PackedMorse& textToPackedMorse(const char* text);
+    const PackedMorse& textToPackedMorse(const char* text, size_t length);
+    const PackedMorse& loadPackedMorse(const uint8_t* bytes, size_t symbolCount, bool truncated);  // A stream saved from bytes(), e.g. a cached echo
+    const char* packedToAscii(const PackedMorse& morse);  // Rendered into the ASCII buffer
+    bool wasTruncated() const;  // Whether the last textToMorse/textToPackedMorse dropped input
     void startPlayback(const char* morse);  // Non-blocking start
-    void updatePlayback();  // Call this from main loop
+    void startPlayback(const PackedMorse& morse);  // morse must outlive playback
+    void startTextPlayback(const char* text, size_t length);  // Encodes lazily; text must outlive playback
+    void beginPlaybackEngine();  // Call from the task that runs updatePlayback(); the timer ISR is bound to its core
+    // Timer backend: called from the ISR, outside its critical section, when the timeline
+    // is half drained, runs dry or ends; wake the task so updatePlayback() refills or finishes it.
+    // The handler must be IRAM-resident.
+    void setPlaybackWakeHandler(void (*handler)(void* context), void* context);
+    bool queueText(const uint8_t* data, size_t length);  // Producer side, any task; false when full. Picked up by updatePlayback()
+    bool queuePacked(const uint8_t* symbols, size_t symbolCount);  // As queueText, for symbols compiled earlier (a preset)
+    // As queueText, but text longer than a queue slot is played from data in place
+    // (a framed transfer's buffer); data must stay untouched while isQueued(data)
+    bool queueTransfer(const uint8_t* data, size_t length);
+    bool isQueued(const uint8_t* data) const;  // Producer side
+    size_t queuedMessages() const;  // Including the one being encoded
+    bool isQueueFull() const;
+    void updatePlayback();  // Call this from the playback task/loop; with the timer backend it starts and compiles ahead, the ISR plays
     bool isPlaybackActive() const;
     void stopPlayback();
+    const PlaybackJitterStats& getJitterStats() const;  // Zeroed unless built with MORSE_JITTER_PROBE
+    uint32_t getMessageDurationMs() const;  // Current message (incl. chained queued ones so far) at the current speed, else the last one as played
+    uint32_t getRemainingMs() const;        // Time left in the current message, 0 when idle
+    PlaybackProgress getPlaybackProgress() const;  // Any task; letter currently sounding
+    MorseTiming setTiming(uint8_t wpm, uint8_t farnsworthWpm = 0);  // Any task; takes effect at the next edge. Returns the clamped setting
+    MorseTiming getTiming() const;  // Including a setting not yet taken up
     
     // LED control
     void setLED(bool state);  // true = on, false = off (handles active LOW)
-    void setPWM(uint8_t value);  // 0-255 for PWM control
+    void setPWM(uint8_t value);  // 0-255 for PWM control; previews one dash at the new intensity while idle
     
-    // Status LED patterns
-    void indicateIdle();        // Steady on
-    void indicateProcessing();  // Fast blink (3 times)
-    void indicatePlaying();     // Single blink
-    void indicateError();       // Rapid blink (5 times)
-    void clearStatus();         // Off
+    // Status LED patterns; none of these block, the pattern plays from updatePlayback()
+    // while idle. Requests made during playback are dropped, and one still pending when
+    // playback starts is cancelled. A request replaces the one pending, so PROCESSING
+    // and PLAYING, which only ever precede a message, are intentionally never shown.
+    void indicateIdle();        // Off
+    void indicateProcessing();  // Short blink; superseded as above
+    void indicatePlaying();     // Short blink; superseded as above
+    void indicateError();       // Rapid blink (3 times)
+    void indicateAdvertising(); // Slow blink until another pattern or playback
+    void clearStatus();         // LED and haptic off
+    bool isStatusPatternActive() const;  // A pattern is running or requested
+    uint32_t getStatusPatternWaitMs() const;  // Until the pattern's next step is due
 };
 
 #endif // MORSE_CONVERTER_H 
\ No newline at end of file
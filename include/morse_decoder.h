@@ -0,0 +1,40 @@
+#ifndef MORSE_DECODER_H
+#define MORSE_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "morse_code.h"
+#include "packed_morse.h"
+
+// Emitted for a complete letter whose dot/dash sequence has no mapping
+const char MORSE_DECODE_UNKNOWN = '*';
+
+// Incremental Morse -> text decoder walking MORSE_DECODE_TREE, one symbol at a time.
+// A letter gap with no letter pending counts as a word gap, so ASCII "  " and a
+// packed WORD_GAP decode the same way.
+class MorseDecoder {
+private:
+    uint16_t node = 1;       // Current tree position; 1 = no letter pending
+    bool invalid = false;    // Current letter ran off the tree
+    bool atWordStart = true; // Suppresses leading and repeated spaces
+
+    size_t endLetter(char* out);
+    size_t finishOutput(char* out, size_t written, size_t outSize);
+
+public:
+    void reset();
+
+    // Feeds one symbol and writes 0-2 decoded characters to out; returns how many
+    size_t push(MorseSymbol symbol, char* out);
+    // Feeds one ASCII character ('.', '-', ' ', '/'); anything else is ignored
+    size_t push(char ascii, char* out);
+    // Flushes a pending letter at end of input
+    size_t finish(char* out);
+
+    // One-shot decoders; output is always NUL-terminated when outSize > 0
+    size_t decode(const char* ascii, char* out, size_t outSize);
+    size_t decode(const PackedMorse& morse, char* out, size_t outSize);
+    size_t decodePacked(const uint8_t* packed, size_t symbolCount, char* out, size_t outSize);
+};
+
+#endif // MORSE_DECODER_H
@@ -0,0 +1,90 @@
+#ifndef MORSE_ECHO_H
+#define MORSE_ECHO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "packed_morse.h"
+
+// Formats of the Morse echo sent back after each message, chosen per connection.
+// ASCII is the original dot/dash string; the binary formats start with a header:
+//   [format][flags][symbol count u16 LE]
+//   PACKED: header + the PackedMorse bytes (4 symbols per byte, first symbol in the low bits)
+//   DIGEST: header + [CRC-32 of the packed bytes, u32 LE]
+//
+// With ECHO_STREAMED or'ed into the format, the echo is instead sent as it is encoded,
+// in notifications of at most the negotiated chunk size:
+//   data chunk: [sequence (0-127, wrapping)][ASCII characters or packed bytes...]
+//   end marker: [ECHO_CHUNK_END | sequence][flags][symbol count u16 LE][CRC-32 u32 LE]
+// DIGEST sends only the end marker. The last packed byte may be partly used; the
+// symbol count says how much.
+//
+// With ECHO_CACHE_AWARE or'ed into the format as well, a message whose echo this
+// connection was already sent in full gets only its digest with ECHO_FLAG_CACHED
+// set: the DIGEST echo, or for streamed echoes an end marker with no chunks before
+// it. The central looks the echo up by symbol count and CRC-32.
+enum class EchoFormat : uint8_t {
+    ASCII = 0,
+    PACKED = 1,
+    DIGEST = 2
+};
+
+const uint8_t ECHO_FLAG_TRUNCATED = 0x01;  // The symbol stream stopped short of the input
+const uint8_t ECHO_FLAG_CACHED = 0x02;     // Digest of an echo the central already has
+const uint8_t ECHO_STREAMED = 0x80;        // Format flag: stream the echo in chunks
+const uint8_t ECHO_CACHE_AWARE = 0x40;     // Format flag: send repeated echoes as digests
+const uint8_t ECHO_CHUNK_END = 0x80;       // Chunk header flag: end-of-message marker
+const size_t ECHO_END_SIZE = 8;
+const size_t ECHO_MIN_CHUNK = ECHO_END_SIZE;
+const size_t ECHO_DEFAULT_CHUNK = 20;      // Default ATT MTU of 23
+#ifndef ECHO_MAX_CHUNK
+#define ECHO_MAX_CHUNK 400                 // morseOutputChar value size
+#endif
+const size_t ECHO_HEADER_SIZE = 4;
+const size_t ECHO_DIGEST_SIZE = ECHO_HEADER_SIZE + 4;
+
+// Bytes PACKED needs for a stream of symbolCount symbols
+constexpr size_t packedEchoSize(size_t symbolCount) {
+    return ECHO_HEADER_SIZE + (symbolCount + 3) / 4;
+}
+
+// Both return the bytes written, or 0 if out is too small
+size_t encodePackedEcho(const PackedMorse& morse, bool truncated, uint8_t* out, size_t outSize);
+size_t encodeDigestEcho(const PackedMorse& morse, bool truncated, uint8_t* out, size_t outSize);
+
+// Digest of an echo already sent, as a DIGEST echo or, if streamed, a lone end marker
+size_t encodeCachedEcho(bool streamed, bool truncated, size_t symbolCount, uint32_t crc, uint8_t* out, size_t outSize);
+
+uint32_t packedMorseCrc32(const PackedMorse& morse);  // Unused bits of the last byte count as 0
+uint32_t packedMorseCrc32(const uint8_t* bytes, size_t symbolCount);  // Same, over PackedMorse-layout bytes
+
+// Receives one notification's worth of echo; false stops the stream
+typedef bool (*EchoChunkSink)(const uint8_t* data, size_t length, void* context);
+
+// Builds a streamed echo symbol by symbol, holding only the chunk being filled
+class EchoStreamer {
+private:
+    uint8_t chunk[ECHO_MAX_CHUNK];
+    size_t chunkSize = ECHO_DEFAULT_CHUNK;
+    size_t fill = 0;
+    uint8_t sequence = 0;
+    EchoFormat format = EchoFormat::ASCII;
+    EchoChunkSink sink = nullptr;
+    void* context = nullptr;
+    bool failed = false;
+
+    uint32_t symbolCount = 0;
+    uint32_t crc = 0;
+    uint8_t packedByte = 0;  // Symbols not yet making up a whole packed byte
+
+    void put(uint8_t byte);
+    void flush();
+    void addPackedByte(uint8_t byte);
+
+public:
+    void begin(EchoFormat format, size_t chunkSize, EchoChunkSink sink, void* context);
+    void add(MorseSymbol symbol);
+    bool finish(bool truncated);  // Sends the rest and the end marker; false if the sink gave up
+    uint32_t symbols() const;
+};
+
+#endif // MORSE_ECHO_H
@@ -0,0 +1,66 @@
+#ifndef MORSE_ENCODER_H
+#define MORSE_ENCODER_H
+
+#include <stddef.h>
+#include "morse_code.h"
+#include "packed_morse.h"
+
+// Outcome of encoding into a caller-supplied buffer
+struct MorseEncodeResult {
+    size_t length;   // Characters written, excluding the terminator
+    bool truncated;  // Output stopped at a letter boundary because the buffer was full
+};
+
+// Text is UTF-8. ASCII bytes take a direct table lookup as before; multi-byte
+// sequences are decoded and looked up in the selected alphabet's tables, also in
+// constant time. Malformed bytes and code points the alphabet lacks are unmapped.
+
+// Returned by decodeUtf8 for a malformed or truncated sequence
+constexpr uint32_t UTF8_INVALID = 0xFFFFFFFF;
+
+// Decodes the sequence at text[0..length) into codePoint and returns the bytes it
+// used, 1 for a malformed one. Stops at the first non-continuation byte, so
+// NUL-terminated text may pass SIZE_MAX as length.
+size_t decodeUtf8(const char* text, size_t length, uint32_t& codePoint);
+
+// Letters for a non-ASCII code point in alphabet, or nullptr if it has none
+const MorseGlyphEntry* morseGlyphFor(uint32_t codePoint, MorseAlphabet alphabet);
+
+// Exact strlen of the ASCII encoding of text: codes joined by one space per input
+// character, a two-letter character counting as two codes
+size_t morseEncodedLength(const char* text, MorseAlphabet alphabet = MorseAlphabet::LATIN);
+
+// Single-pass ASCII encoder; output is always NUL-terminated when outSize > 0
+MorseEncodeResult encodeMorse(const char* text, char* out, size_t outSize,
+                              MorseAlphabet alphabet = MorseAlphabet::LATIN);
+
+// Resumable text -> symbol encoder. Holds only a cursor into caller-owned text,
+// so its state stays a few bytes regardless of message length. Gap rules match
+// textToPackedMorse: unmapped characters are skipped, spaces between letters become
+// one word gap, and leading/trailing gaps are never emitted.
+class MorseStreamEncoder {
+private:
+    const char* text = nullptr;
+    size_t textLength = 0;
+    size_t position = 0;
+    size_t letterStart = 0;
+    PackedCode code = {0, 0};
+    PackedCode secondLetter = {0, 0};  // Still to send for the current character
+    uint8_t symbolIndex = 0;
+    bool started = false;
+    MorseAlphabet alphabet = MorseAlphabet::LATIN;
+
+    bool startLetter(PackedCode nextCode, size_t start, bool crossedSpace, MorseSymbol& symbol);
+    bool nextLetterUtf8(MorseSymbol& symbol, bool crossedSpace);
+
+public:
+    void begin(const char* text, MorseAlphabet alphabet = MorseAlphabet::LATIN);  // NUL-terminated
+    void begin(const char* text, size_t length, MorseAlphabet alphabet = MorseAlphabet::LATIN);
+    void reset();
+
+    bool next(MorseSymbol& symbol);  // false once the text is exhausted
+    size_t textPosition() const;     // Input bytes consumed so far; a two-letter character counts once both are sent
+    size_t letterPosition() const;   // Byte offset of the character being sent
+};
+
+#endif // MORSE_ENCODER_H
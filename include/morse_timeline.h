@@ -0,0 +1,121 @@
+#ifndef MORSE_TIMELINE_H
+#define MORSE_TIMELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "packed_morse.h"
+
+// Events buffered ahead of playback; refilled from the symbol source as it drains.
+// A power of two, so the free-running ring indices wrap cleanly.
+#ifndef MORSE_TIMELINE_CAPACITY
+#define MORSE_TIMELINE_CAPACITY 64
+#endif
+static_assert(MORSE_TIMELINE_CAPACITY >= 4 && MORSE_TIMELINE_CAPACITY <= 32768
+                  && (MORSE_TIMELINE_CAPACITY & (MORSE_TIMELINE_CAPACITY - 1)) == 0,
+              "MORSE_TIMELINE_CAPACITY must be a power of two from 4 to 32768");
+
+// Standard (PARIS) element lengths in dot units
+const uint8_t DOT_UNITS = 1;
+const uint8_t DASH_UNITS = 3;
+const uint8_t SYMBOL_GAP_UNITS = 1;
+const uint8_t LETTER_GAP_UNITS = 3;
+const uint8_t WORD_GAP_UNITS = 7;
+
+// One output level held for a number of dot units, packed as level << 7 | units
+typedef uint8_t TimelineEvent;
+
+inline TimelineEvent makeTimelineEvent(bool level, uint8_t units) {
+    return static_cast<TimelineEvent>((level ? 0x80 : 0) | (units & 0x7F));
+}
+
+inline bool timelineEventLevel(TimelineEvent event) {
+    return event & 0x80;
+}
+
+inline uint8_t timelineEventUnits(TimelineEvent event) {
+    return event & 0x7F;
+}
+
+// Off events of these lengths are the gaps Farnsworth timing stretches
+inline bool isLetterGapEvent(TimelineEvent event) {
+    return event == makeTimelineEvent(false, LETTER_GAP_UNITS);
+}
+
+inline bool isWordGapEvent(TimelineEvent event) {
+    return event == makeTimelineEvent(false, WORD_GAP_UNITS);
+}
+
+// Character speed limits; the dot is 1200 ms / WPM (PARIS), so 12 WPM = 100 ms
+const uint8_t MIN_WPM = 5;
+const uint8_t MAX_WPM = 60;
+const uint8_t DEFAULT_WPM = 12;
+
+// Event durations for one speed setting. With Farnsworth timing, letters are sent at
+// wpm and only the letter and word gaps are stretched to bring the overall speed
+// down to farnsworthWpm.
+struct MorseTiming {
+    uint8_t wpm;
+    uint8_t farnsworthWpm;  // Equal to wpm for standard spacing
+    uint32_t dotUs;
+    uint32_t letterGapUs;
+    uint32_t wordGapUs;
+};
+
+// Clamps both speeds to MIN_WPM..MAX_WPM; a farnsworthWpm of 0 or above wpm means standard spacing
+MorseTiming makeMorseTiming(uint8_t wpm, uint8_t farnsworthWpm = 0);
+uint32_t timelineEventDurationUs(const MorseTiming& timing, TimelineEvent event);
+
+// A stretch of timeline, counted so it can be timed at any speed
+struct TimelineLength {
+    uint32_t elementUnits = 0;  // Marks and gaps inside letters, in dot units
+    uint32_t letterGaps = 0;
+    uint32_t wordGaps = 0;
+
+    void add(TimelineEvent event);
+    void add(const TimelineLength& other);
+    bool isEmpty() const;
+    uint64_t durationUs(const MorseTiming& timing) const;
+    TimelineLength remainingAfter(const TimelineLength& played) const;
+};
+
+// Turns a symbol stream into alternating on/off events. Each gap becomes a single
+// off event of the full standard length (1, 3 or 7 units) and no gap is emitted
+// before the first mark or after the last one.
+class TimelineCompiler {
+private:
+    uint8_t pendingGap = 0;  // Off units owed before the next mark
+    bool afterMark = false;
+
+public:
+    void reset();
+    // Compiles one symbol into 0-2 events; returns how many were written
+    uint8_t compile(MorseSymbol symbol, TimelineEvent* events);
+};
+
+// Lock-free single-producer/single-consumer FIFO of compiled events. The producer
+// (playback task) compiles symbols ahead of time; the consumer (the playback edge,
+// in the timer ISR with that backend) only pops, so pop() is kept in IRAM.
+class MorseTimeline {
+private:
+    TimelineEvent events[MORSE_TIMELINE_CAPACITY];
+    uint32_t marks[MORSE_TIMELINE_CAPACITY];  // Packed PlaybackProgress of each mark event
+    std::atomic<uint16_t> head{0};  // Free-running; advanced by the consumer
+    std::atomic<uint16_t> tail{0};  // Free-running; advanced by the producer
+    TimelineCompiler compiler;
+
+public:
+    static const uint16_t CAPACITY = MORSE_TIMELINE_CAPACITY;
+
+    void clear();  // Only while nothing is popping
+    // Producer side
+    bool hasRoom() const;  // Space for the events of one more symbol
+    void push(MorseSymbol symbol, uint32_t markProgress);  // markProgress goes with the symbol's mark, if any
+    // Consumer side
+    bool pop(TimelineEvent& event, uint32_t& markProgress);
+
+    bool isEmpty() const;
+    uint16_t size() const;
+};
+
+#endif // MORSE_TIMELINE_H
@@ -0,0 +1,209 @@
+// Generated by scripts/gen_morse_tables.py from alphabets/*.csv; edit the CSVs, not this file.
+// Included from morse_encoder.cpp only. Constant data, so on the ESP32 it stays in flash.
+#pragma once
+
+// Code points per alphabet: LATIN 138, CYRILLIC 74, GREEK 69, WABUN 180
+
+constexpr int MORSE_GLYPH_COUNT = 170;
+inline constexpr MorseGlyphEntry MORSE_GLYPHS[MORSE_GLYPH_COUNT] = {
+    {MorseAlphabet::LATIN, {{5, 0x16}, {0, 0}}}, {MorseAlphabet::LATIN, {{2, 0x02}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{4, 0x0a}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x05}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{5, 0x12}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x04}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{1, 0x00}, {0, 0}}}, {MorseAlphabet::LATIN, {{2, 0x00}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{5, 0x0c}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x1b}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x07}, {0, 0}}}, {MorseAlphabet::LATIN, {{4, 0x07}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x04}, {0, 0}}}, {MorseAlphabet::LATIN, {{4, 0x0c}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{4, 0x0d}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x06}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x00}, {3, 0x00}}}, {MorseAlphabet::LATIN, {{4, 0x05}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x01}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x0b}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x03}, {0, 0}}}, {MorseAlphabet::LATIN, {{4, 0x0f}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{5, 0x0e}, {0, 0}}}, {MorseAlphabet::LATIN, {{2, 0x01}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x07}, {1, 0x00}}}, {MorseAlphabet::LATIN, {{3, 0x02}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{7, 0x08}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x08}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{3, 0x00}, {0, 0}}}, {MorseAlphabet::LATIN, {{1, 0x01}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{6, 0x13}, {0, 0}}}, {MorseAlphabet::LATIN, {{5, 0x13}, {0, 0}}},
+    {MorseAlphabet::LATIN, {{4, 0x03}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{1, 0x00}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{5, 0x04}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{2, 0x00}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{5, 0x0e}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{2, 0x02}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x01}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{3, 0x06}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{3, 0x03}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{3, 0x01}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x08}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{4, 0x03}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x0e}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{3, 0x05}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x02}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{2, 0x03}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{2, 0x01}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{3, 0x07}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x06}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{3, 0x02}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{3, 0x00}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{1, 0x01}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{3, 0x04}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{4, 0x04}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x00}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{4, 0x05}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x07}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{4, 0x0f}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x0b}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{5, 0x1b}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x0d}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{4, 0x09}, {0, 0}}},
+    {MorseAlphabet::CYRILLIC, {{4, 0x0c}, {0, 0}}}, {MorseAlphabet::CYRILLIC, {{4, 0x0a}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{2, 0x02}, {0, 0}}}, {MorseAlphabet::GREEK, {{1, 0x00}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{4, 0x00}, {0, 0}}}, {MorseAlphabet::GREEK, {{2, 0x00}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{3, 0x07}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x0d}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{3, 0x06}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x01}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{3, 0x03}, {0, 0}}}, {MorseAlphabet::GREEK, {{3, 0x01}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{4, 0x03}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x05}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{3, 0x05}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x02}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{2, 0x03}, {0, 0}}}, {MorseAlphabet::GREEK, {{2, 0x01}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{4, 0x09}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x06}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{3, 0x02}, {0, 0}}}, {MorseAlphabet::GREEK, {{3, 0x00}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{1, 0x01}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x04}, {0, 0}}},
+    {MorseAlphabet::GREEK, {{4, 0x0f}, {0, 0}}}, {MorseAlphabet::GREEK, {{4, 0x0b}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{6, 0x2a}, {0, 0}}}, {MorseAlphabet::WABUN, {{6, 0x0a}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{6, 0x12}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x1b}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{2, 0x02}, {0, 0}}}, {MorseAlphabet::WABUN, {{3, 0x04}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{5, 0x1d}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x02}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x02}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x02}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x05}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x05}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{4, 0x08}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x08}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{4, 0x0d}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x0d}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{4, 0x0f}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x0f}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x15}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x15}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x0b}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x0b}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x17}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x17}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x0e}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x0e}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{4, 0x07}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x07}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{2, 0x01}, {0, 0}}}, {MorseAlphabet::WABUN, {{2, 0x01}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{4, 0x04}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x04}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{4, 0x06}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x06}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x1a}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x1a}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x04}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x04}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{3, 0x02}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x05}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x00}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x0b}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x0c}, {0, 0}}}, {MorseAlphabet::WABUN, {{4, 0x01}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x01}, {2, 0x00}}}, {MorseAlphabet::WABUN, {{4, 0x01}, {5, 0x0c}}},
+    {MorseAlphabet::WABUN, {{5, 0x13}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x13}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{5, 0x13}, {5, 0x0c}}}, {MorseAlphabet::WABUN, {{4, 0x03}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x03}, {2, 0x00}}}, {MorseAlphabet::WABUN, {{4, 0x03}, {5, 0x0c}}},
+    {MorseAlphabet::WABUN, {{1, 0x00}, {0, 0}}}, {MorseAlphabet::WABUN, {{1, 0x00}, {2, 0x00}}},
+    {MorseAlphabet::WABUN, {{1, 0x00}, {5, 0x0c}}}, {MorseAlphabet::WABUN, {{3, 0x01}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{3, 0x01}, {2, 0x00}}}, {MorseAlphabet::WABUN, {{3, 0x01}, {5, 0x0c}}},
+    {MorseAlphabet::WABUN, {{4, 0x09}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x14}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{1, 0x01}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x11}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{5, 0x09}, {0, 0}}}, {MorseAlphabet::WABUN, {{3, 0x06}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{5, 0x19}, {0, 0}}}, {MorseAlphabet::WABUN, {{2, 0x03}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{3, 0x00}, {0, 0}}}, {MorseAlphabet::WABUN, {{3, 0x03}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{5, 0x0d}, {0, 0}}}, {MorseAlphabet::WABUN, {{3, 0x07}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x0a}, {0, 0}}}, {MorseAlphabet::WABUN, {{3, 0x05}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{5, 0x12}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x06}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{4, 0x0e}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x0a}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{3, 0x04}, {2, 0x00}}}, {MorseAlphabet::WABUN, {{2, 0x00}, {0, 0}}},
+    {MorseAlphabet::WABUN, {{5, 0x0c}, {0, 0}}}, {MorseAlphabet::WABUN, {{5, 0x16}, {0, 0}}}
+};
+
+// Code point >> 8 -> MORSE_UNICODE_PAGES index, for the Basic Multilingual Plane
+inline constexpr MorseEncodeIndex MORSE_UNICODE_PAGE_INDEX = {{
+    0x00, 0x01, 0xff, 0x02, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x04, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+}};
+
+// Code point & 0xFF -> MORSE_GLYPHS index, one table per page in use
+constexpr int MORSE_UNICODE_PAGE_COUNT = 5;
+inline constexpr MorseEncodeIndex MORSE_UNICODE_PAGES[MORSE_UNICODE_PAGE_COUNT] = {
+    {{  // U+0000
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0x00, 0x01, 0x01, 0x01, 0x02, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x06, 0x07, 0x07, 0x07, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0a, 0x0a, 0x0b, 0xff, 0x0b, 0x0c, 0x0c, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+        0x00, 0x01, 0x01, 0x01, 0x02, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x06, 0x07, 0x07, 0x07, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0a, 0x0a, 0x0b, 0xff, 0x0b, 0x0c, 0x0c, 0x0c, 0x0d, 0x0e, 0x0f, 0x0e
+    }},
+    {{  // U+0100
+        0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0xff, 0xff, 0x11, 0x11, 0x12, 0x12,
+        0x12, 0x12, 0x06, 0x06, 0xff, 0xff, 0x06, 0x06, 0x05, 0x05, 0x06, 0x06, 0x13, 0x13, 0x14, 0x14,
+        0xff, 0xff, 0xff, 0xff, 0x15, 0x15, 0xff, 0xff, 0xff, 0xff, 0x07, 0x07, 0xff, 0xff, 0xff, 0xff,
+        0x07, 0xff, 0xff, 0xff, 0x16, 0x16, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x04, 0x04, 0x09, 0x09, 0xff, 0xff, 0x17, 0x17, 0xff, 0xff, 0xff, 0x0a, 0x0a, 0xff, 0xff,
+        0x0a, 0x0a, 0x18, 0x18, 0xff, 0xff, 0xff, 0xff, 0x19, 0x19, 0x1a, 0x1a, 0x1b, 0x1b, 0x1c, 0x1c,
+        0x15, 0x15, 0x1d, 0x1d, 0x1d, 0x1d, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x0c, 0x0d, 0x0d, 0x0c, 0x0c,
+        0x0c, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0e, 0x1e, 0x1e, 0x1f, 0x1f, 0x20, 0x20, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    }},
+    {{  // U+0300
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0xff, 0x43, 0x44, 0x45, 0xff, 0x46, 0xff, 0x47, 0x48,
+        0x45, 0x42, 0x49, 0x4a, 0x4b, 0x43, 0x4c, 0x44, 0x4d, 0x45, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x46,
+        0x53, 0x54, 0xff, 0x55, 0x56, 0x47, 0x57, 0x58, 0x59, 0x48, 0x45, 0x47, 0x42, 0x43, 0x44, 0x45,
+        0x47, 0x42, 0x49, 0x4a, 0x4b, 0x43, 0x4c, 0x44, 0x4d, 0x45, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x46,
+        0x53, 0x54, 0x55, 0x55, 0x56, 0x47, 0x57, 0x58, 0x59, 0x48, 0x45, 0x47, 0x46, 0x47, 0x48, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    }},
+    {{  // U+0400
+        0xff, 0x21, 0xff, 0xff, 0x22, 0xff, 0x23, 0x24, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0x25, 0x26, 0x27, 0x28, 0x29, 0x21, 0x2a, 0x2b, 0x23, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x22, 0x40, 0x41,
+        0x25, 0x26, 0x27, 0x28, 0x29, 0x21, 0x2a, 0x2b, 0x23, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x22, 0x40, 0x41,
+        0xff, 0x21, 0xff, 0xff, 0x22, 0xff, 0x23, 0x24, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0x28, 0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    }},
+    {{  // U+3000
+        0xff, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5b, 0x5c, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0x5d, 0x5d, 0x5e, 0x5e, 0x5f, 0x5f, 0x60, 0x60, 0x61, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
+        0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76,
+        0x77, 0x78, 0x79, 0x7a, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85,
+        0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95,
+        0x96, 0x97, 0x98, 0x99, 0x99, 0x9a, 0x9a, 0x9b, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f, 0xa0, 0xa1, 0xa1,
+        0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0x62, 0x68, 0xff, 0xff, 0xa7, 0xa8, 0xa7, 0xa8, 0xff, 0xff, 0xff,
+        0xff, 0x5d, 0x5d, 0x5e, 0x5e, 0x5f, 0x5f, 0x60, 0x60, 0x61, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
+        0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76,
+        0x77, 0x78, 0x79, 0x7a, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85,
+        0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95,
+        0x96, 0x97, 0x98, 0x99, 0x99, 0x9a, 0x9a, 0x9b, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f, 0xa0, 0xa1, 0xa1,
+        0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0x62, 0x68, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa9, 0xff, 0xff, 0xff
+    }}
+};
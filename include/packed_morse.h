@@ -0,0 +1,54 @@
+#ifndef PACKED_MORSE_H
+#define PACKED_MORSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "morse_code.h"
+
+// Symbol capacity of a PackedMorse stream (4 symbols per byte)
+#ifndef PACKED_MORSE_CAPACITY
+#define PACKED_MORSE_CAPACITY 1024
+#endif
+
+// 2-bit symbols stored in a PackedMorse stream
+enum class MorseSymbol : uint8_t {
+    DOT = 0,
+    DASH = 1,
+    LETTER_GAP = 2,
+    WORD_GAP = 3
+};
+
+// Symbol index of a stream in PackedMorse layout
+inline MorseSymbol packedSymbolAt(const uint8_t* bytes, size_t index) {
+    return static_cast<MorseSymbol>((bytes[index >> 2] >> ((index & 3) * 2)) & 0x3);
+}
+
+// Fixed-capacity Morse symbol stream packed 4 symbols to a byte
+class PackedMorse {
+private:
+    uint8_t data[PACKED_MORSE_CAPACITY / 4] = {};
+    size_t count = 0;
+
+public:
+    static const size_t CAPACITY = PACKED_MORSE_CAPACITY;
+
+    void clear();
+    bool append(MorseSymbol symbol);  // false if the stream is full
+    bool appendCode(PackedCode code);  // Appends every symbol of one character
+    void setLast(MorseSymbol symbol);
+    void truncate(size_t length);  // Drops symbols past length
+    bool assign(const uint8_t* bytes, size_t symbolCount);  // Copies a stream in bytes() layout; false if too long
+
+    MorseSymbol at(size_t index) const;
+    const uint8_t* bytes() const;  // Symbol i is bits 2*(i%4)..2*(i%4)+1 of byte i/4
+    size_t length() const;
+    bool isEmpty() const;
+
+    // Parses an ASCII dot/dash string; one space is a letter gap, two or more a word gap
+    bool fromAscii(const char* morse);
+
+    // Renders as ASCII ('.', '-', ' ' per letter gap, "  " per word gap), always NUL-terminated
+    size_t toAscii(char* out, size_t outSize) const;
+};
+
+#endif // PACKED_MORSE_H
@@ -0,0 +1,36 @@
+#ifndef PLAYBACK_PROGRESS_H
+#define PLAYBACK_PROGRESS_H
+
+#include <stdint.h>
+
+// Symbol steps inside one letter are reported at most this often; letter
+// boundaries and start/stop go out as soon as they are seen
+#ifndef PROGRESS_MIN_INTERVAL_MS
+#define PROGRESS_MIN_INTERVAL_MS 50
+#endif
+
+// Position of the letter being played, as heard rather than as encoded
+struct PlaybackProgress {
+    bool playing;
+    uint8_t message;     // Queued messages finished before this one since playback started
+    uint16_t character;  // Byte offset of the letter in its message text; letter index for Morse playback
+    uint8_t symbol;      // Element within that letter, from 0
+
+    // Packed for handing between tasks as one word
+    uint32_t pack() const;
+    static PlaybackProgress unpack(uint32_t packed);
+};
+
+// Coalesces progress samples into notifications; the caller samples as often as
+// it likes and sends only when shouldSend() says so
+class ProgressThrottle {
+private:
+    PlaybackProgress sent = {};
+    uint32_t sentMs = 0;
+
+public:
+    void reset();
+    bool shouldSend(const PlaybackProgress& progress, uint32_t nowMs);
+};
+
+#endif // PLAYBACK_PROGRESS_H
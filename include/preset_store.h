@@ -0,0 +1,99 @@
+#ifndef PRESET_STORE_H
+#define PRESET_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "message_queue.h"
+#include "packed_morse.h"
+
+// Canned messages compiled once and played by ID, so sending one costs a short
+// write instead of its text and playback starts without encoding. The app drives
+// them through the Presets characteristic:
+//
+//   STORE:  [0x01][id u16][UTF-8 text]  compiled with the selected alphabet and saved
+//   DELETE: [0x02][id u16]
+//           Both write flash, which holds off playback, so they answer BUSY while a
+//           message plays
+//   PLAY:   [0x03][id u8 or u16]        queued behind any message already playing
+//   LIST:   [0x04]
+//
+// Each write leaves its result in the characteristic (read, and notified):
+//   [op][PresetStatus][id u16], or for LIST [op][status][count] then
+//   [id u16][symbol count u16] per preset, in slot order.
+//
+// Presets persist as one blob per slot: [id u16][symbol count u16][PackedMorse bytes].
+
+// Presets kept
+#ifndef MORSE_PRESET_COUNT
+#define MORSE_PRESET_COUNT 16
+#endif
+
+// Longest preset, in symbols
+#ifndef MORSE_PRESET_SYMBOLS
+#define MORSE_PRESET_SYMBOLS 512
+#endif
+
+// PLAY copies a preset into a queue slot, which would turn one that does not fit
+// into a QUEUE_FULL that never clears
+static_assert(MORSE_PRESET_SYMBOLS <= MORSE_QUEUE_SYMBOLS, "A preset must fit a queue slot (MORSE_QUEUE_SYMBOLS)");
+
+const uint8_t PRESET_STORE = 0x01;
+const uint8_t PRESET_DELETE = 0x02;
+const uint8_t PRESET_PLAY = 0x03;
+const uint8_t PRESET_LIST = 0x04;
+
+enum class PresetStatus : uint8_t {
+    OK = 0,
+    NOT_FOUND = 1,
+    FULL = 2,           // Every slot holds another preset
+    TOO_LARGE = 3,      // More than MORSE_PRESET_SYMBOLS symbols
+    EMPTY = 4,          // The text has no Morse
+    QUEUE_FULL = 5,     // PLAY: retry once playback drains
+    INVALID = 6,        // Unknown op or short write
+    STORAGE_ERROR = 7,  // Compiled, but not saved to flash
+    BUSY = 8            // STORE/DELETE: a message is playing; retry once it is done
+};
+
+const size_t PRESET_RESULT_SIZE = 4;
+const size_t PRESET_LIST_HEADER_SIZE = 3;
+const size_t PRESET_LIST_ENTRY_SIZE = 4;
+const size_t PRESET_IMAGE_HEADER_SIZE = 4;
+
+// Bytes the persisted blob of a preset takes
+constexpr size_t presetImageSize(size_t symbolCount) {
+    return PRESET_IMAGE_HEADER_SIZE + (symbolCount + 3) / 4;
+}
+
+struct MorsePreset {
+    uint16_t id;
+    uint16_t symbolCount;  // 0 for a free slot
+    uint8_t packed[MORSE_PRESET_SYMBOLS / 4];
+};
+
+// Fixed pool of presets held in RAM, where PLAY reads them; the caller persists
+// the slots store() and remove() report and loads them back at boot.
+class PresetStore {
+private:
+    MorsePreset slots[MORSE_PRESET_COUNT] = {};
+
+public:
+    static const size_t CAPACITY = MORSE_PRESET_COUNT;
+    static const size_t MAX_SYMBOLS = MORSE_PRESET_SYMBOLS;
+    static const size_t MAX_IMAGE_SIZE = presetImageSize(MORSE_PRESET_SYMBOLS);
+    static const size_t MAX_LIST_SIZE = PRESET_LIST_HEADER_SIZE + MORSE_PRESET_COUNT * PRESET_LIST_ENTRY_SIZE;
+
+    // Replaces the preset with this id, or takes a free slot; slot is the one written
+    PresetStatus store(uint16_t id, const PackedMorse& morse, size_t& slot);
+    PresetStatus remove(uint16_t id, size_t& slot);
+    const MorsePreset* find(uint16_t id) const;  // nullptr if there is none
+    size_t size() const;
+
+    // Persisted form of one slot; 0 for a free slot
+    size_t saveSlot(size_t slot, uint8_t* out, size_t outSize) const;
+    bool loadSlot(size_t slot, const uint8_t* data, size_t length);  // false if the blob is malformed
+
+    // LIST result for the characteristic; returns the bytes written
+    size_t list(uint8_t* out, size_t outSize) const;
+};
+
+#endif // PRESET_STORE_H
@@ -0,0 +1,49 @@
+#ifndef STATUS_PATTERN_H
+#define STATUS_PATTERN_H
+
+#include <stdint.h>
+
+// Status LED and haptic preview patterns, played without blocking
+enum class StatusPattern : uint8_t {
+    NONE,            // No request pending
+    OFF,             // LED and haptic off
+    IDLE,            // LED off
+    STARTUP,         // Three quick blinks
+    PROCESSING,      // Short blink
+    PLAYING,         // Short blink
+    ERROR,           // Three rapid blinks
+    ADVERTISING,     // 500 ms on/off, repeating
+    HAPTIC_PREVIEW   // One dash at the haptic intensity
+};
+
+// Outputs a step drives
+const uint8_t PATTERN_LED = 0x01;
+const uint8_t PATTERN_HAPTIC = 0x02;
+
+struct PatternStep {
+    uint8_t outputs;      // PATTERN_LED / PATTERN_HAPTIC bits
+    bool level;
+    uint16_t durationMs;  // Hold time before the next step
+};
+
+// Steps through one pattern from the pattern table; the caller drives the outputs
+class StatusSequencer {
+private:
+    const PatternStep* steps = nullptr;
+    uint8_t stepCount = 0;
+    uint8_t stepIndex = 0;
+    bool repeat = false;
+    bool stepPending = false;  // Current step not yet handed out
+    StatusPattern pattern = StatusPattern::NONE;
+    unsigned long stepStartMs = 0;
+
+public:
+    void start(StatusPattern pattern, unsigned long nowMs);  // Restarting a repeating pattern is a no-op
+    void cancel();
+    bool isActive() const;
+    // Hands out the next step once it is due; call until it returns false
+    bool update(unsigned long nowMs, PatternStep& step);
+    uint32_t msUntilNextStep(unsigned long nowMs) const;  // 0 when inactive or due now
+};
+
+#endif // STATUS_PATTERN_H
@@ -1,4 +1,5 @@
 import 'dart:async';
+import 'dart:convert';
 import 'package:flutter/material.dart';
 import '../services/ble_service.dart';
 
@@ -15,16 +16,21 @@ class _MorseScreenState extends State<MorseScreen> {
   String _morseOutput = '';
   int _deviceStatus = BleService.STATUS_IDLE;
   double _hapticIntensity = 0.5; // 0.0 to 1.0
+  final List<String> _playingTexts = []; // Sent since the device was last idle
+  PlaybackProgress? _progress;
+  List<int> _presetIds = [];
 
   StreamSubscription? _morseSubscription;
   StreamSubscription? _statusSubscription;
   StreamSubscription? _connectionSubscription;
+  StreamSubscription? _progressSubscription;
   Timer? _reconnectTimer;
 
   @override
   void initState() {
     super.initState();
     _setupStreams();
+    _loadPresets();
   }
 
   void _setupStreams() {
@@ -54,6 +60,14 @@ class _MorseScreenState extends State<MorseScreen> {
         if (mounted) {
           setState(() {
             _deviceStatus = status;
+            // Progress counts messages from the start of playback
+            if (status == BleService.STATUS_IDLE) {
+              _playingTexts.clear();
+              _progress = null;
+            } else if (status == BleService.STATUS_QUEUE_FULL &&
+                _playingTexts.isNotEmpty) {
+              _playingTexts.removeLast();
+            }
           });
         }
       },
@@ -70,6 +84,14 @@ class _MorseScreenState extends State<MorseScreen> {
       },
     );
 
+    _progressSubscription = _bleService.progressStream.listen((progress) {
+      if (mounted) {
+        setState(() {
+          _progress = progress.playing ? progress : null;
+        });
+      }
+    });
+
     // Set up connection state monitoring
     _connectionSubscription = _bleService.connectionStream.listen(
       (isConnected) {
@@ -110,6 +132,8 @@ class _MorseScreenState extends State<MorseScreen> {
         return 'Playing Morse Code';
       case BleService.STATUS_ERROR:
         return 'Error';
+      case BleService.STATUS_QUEUE_FULL:
+        return 'Queue full - try again shortly';
       default:
         return 'Unknown';
     }
@@ -119,10 +143,13 @@ class _MorseScreenState extends State<MorseScreen> {
     if (_textController.text.isEmpty) return;
 
     try {
-      await _bleService.sendText(_textController.text);
+      final text = _textController.text;
+      _playingTexts.add(text);
+      await _bleService.sendTextFramed(text);
       // Clear text field after successful send
       _textController.clear();
     } catch (e) {
+      if (_playingTexts.isNotEmpty) _playingTexts.removeLast();
       if (mounted) {
         ScaffoldMessenger.of(context).showSnackBar(
           SnackBar(
@@ -134,6 +161,123 @@ class _MorseScreenState extends State<MorseScreen> {
     }
   }
 
+  // The message being played with its current letter highlighted
+  Widget? _buildProgress() {
+    final progress = _progress;
+    if (progress == null || progress.message >= _playingTexts.length) {
+      return null;
+    }
+    final bytes = utf8.encode(_playingTexts[progress.message]);
+    if (progress.character >= bytes.length) return null;
+    // The whole UTF-8 character, continuation bytes included
+    var end = progress.character + 1;
+    while (end < bytes.length && (bytes[end] & 0xC0) == 0x80) {
+      end++;
+    }
+    return RichText(
+      text: TextSpan(
+        style: const TextStyle(fontSize: 18.0, color: Colors.black),
+        children: [
+          TextSpan(text: utf8.decode(bytes.sublist(0, progress.character), allowMalformed: true)),
+          TextSpan(
+            text: utf8.decode(bytes.sublist(progress.character, end), allowMalformed: true),
+            style: TextStyle(
+              fontWeight: FontWeight.bold,
+              backgroundColor: Colors.amber.shade200,
+            ),
+          ),
+          TextSpan(
+            text: utf8.decode(bytes.sublist(end), allowMalformed: true),
+            style: TextStyle(color: Colors.grey.shade600),
+          ),
+        ],
+      ),
+    );
+  }
+
+  Future<void> _loadPresets() async {
+    if (!_bleService.hasPresets) return;
+    try {
+      final ids = await _bleService.listPresets();
+      if (mounted) setState(() => _presetIds = ids);
+    } catch (e) {
+      print('Error listing presets: $e');
+    }
+  }
+
+  void _showPresetError(String action, Object error) {
+    if (!mounted) return;
+    const reasons = {
+      BleService.PRESET_NOT_FOUND: 'not found',
+      BleService.PRESET_FULL: 'all preset slots are in use',
+      BleService.PRESET_TOO_LARGE: 'text too long',
+      BleService.PRESET_EMPTY: 'no Morse in this text',
+      BleService.PRESET_QUEUE_FULL: 'queue full',
+      BleService.PRESET_STORAGE_ERROR: 'could not save to flash',
+      BleService.PRESET_BUSY: 'wait until playback finishes',
+    };
+    ScaffoldMessenger.of(context).showSnackBar(
+      SnackBar(
+        content: Text('Failed to $action preset: ${reasons[error] ?? error}'),
+        backgroundColor: Colors.red,
+      ),
+    );
+  }
+
+  // Saves the entered text under the lowest free id
+  Future<void> _savePreset() async {
+    final text = _textController.text;
+    if (text.isEmpty) return;
+    var id = 1;
+    while (_presetIds.contains(id)) {
+      id++;
+    }
+    try {
+      final status = await _bleService.storePreset(id, text);
+      if (status != BleService.PRESET_OK) {
+        _showPresetError('save', status);
+      }
+      await _loadPresets();
+    } catch (e) {
+      _showPresetError('save', e);
+    }
+  }
+
+  Future<void> _playPreset(int id) async {
+    // Progress within a preset counts letters rather than text bytes, so it is not highlighted
+    _playingTexts.add('');
+    try {
+      final status = await _bleService.playPreset(id);
+      if (status == BleService.PRESET_OK) return;
+      // A full queue is undone by the status notification
+      if (status != BleService.PRESET_QUEUE_FULL && _playingTexts.isNotEmpty) {
+        _playingTexts.removeLast();
+      }
+      _showPresetError('play', status);
+    } catch (e) {
+      if (_playingTexts.isNotEmpty) _playingTexts.removeLast();
+      _showPresetError('play', e);
+    }
+  }
+
+  Future<void> _deletePreset(int id) async {
+    try {
+      final status = await _bleService.deletePreset(id);
+      if (status != BleService.PRESET_OK) {
+        _showPresetError('delete', status);
+      }
+      await _loadPresets();
+    } catch (e) {
+      _showPresetError('delete', e);
+    }
+  }
+
+  Future<void> _updateAlphabet(int? value) async {
+    if (value == null) return;
+    await _bleService.setAlphabet(value);
+    if (mounted) setState(() {});
+  }
+
   Future<void> _updateHapticIntensity(double value) async {
     setState(() {
       _hapticIntensity = value;
@@ -157,6 +301,7 @@ class _MorseScreenState extends State<MorseScreen> {
 
   @override
   Widget build(BuildContext context) {
+    final progressView = _buildProgress();
     return Scaffold(
       appBar: AppBar(
         title: const Text('MorseCodify'),
@@ -187,6 +332,12 @@ class _MorseScreenState extends State<MorseScreen> {
             ),
             const SizedBox(height: 16.0),
 
+            // Letter being played
+            if (progressView != null) ...[
+              progressView,
+              const SizedBox(height: 16.0),
+            ],
+
             // Text input
             TextField(
               controller: _textController,
@@ -202,6 +353,31 @@ class _MorseScreenState extends State<MorseScreen> {
             ),
             const SizedBox(height: 16.0),
 
+            // Presets: tap to play, long press to delete
+            if (_bleService.hasPresets) ...[
+              Wrap(
+                spacing: 8.0,
+                runSpacing: 4.0,
+                crossAxisAlignment: WrapCrossAlignment.center,
+                children: [
+                  for (final id in _presetIds)
+                    GestureDetector(
+                      onLongPress: () => _deletePreset(id),
+                      child: ActionChip(
+                        label: Text(_bleService.presetTexts[id] ?? 'Preset $id'),
+                        onPressed: () => _playPreset(id),
+                      ),
+                    ),
+                  TextButton.icon(
+                    icon: const Icon(Icons.bookmark_add),
+                    label: const Text('Save as preset'),
+                    onPressed: _savePreset,
+                  ),
+                ],
+              ),
+              const SizedBox(height: 8.0),
+            ],
+
             // Morse code output
             Container(
               padding: const EdgeInsets.all(16.0),
@@ -235,6 +411,37 @@ class _MorseScreenState extends State<MorseScreen> {
             ),
             const SizedBox(height: 24.0),
 
+            // Alphabet for non-ASCII text
+            Row(
+              children: [
+                const Text(
+                  'Alphabet',
+                  style: TextStyle(
+                    fontWeight: FontWeight.bold,
+                    fontSize: 16.0,
+                  ),
+                ),
+                const SizedBox(width: 16.0),
+                DropdownButton<int>(
+                  value: _bleService.alphabet,
+                  onChanged: _updateAlphabet,
+                  items: const [
+                    DropdownMenuItem(
+                        value: BleService.ALPHABET_LATIN, child: Text('Latin')),
+                    DropdownMenuItem(
+                        value: BleService.ALPHABET_CYRILLIC,
+                        child: Text('Cyrillic')),
+                    DropdownMenuItem(
+                        value: BleService.ALPHABET_GREEK, child: Text('Greek')),
+                    DropdownMenuItem(
+                        value: BleService.ALPHABET_WABUN,
+                        child: Text('Wabun (kana)')),
+                  ],
+                ),
+              ],
+            ),
+            const SizedBox(height: 16.0),
+
             // Haptic intensity control
             Column(
               crossAxisAlignment: CrossAxisAlignment.start,
@@ -274,6 +481,7 @@ class _MorseScreenState extends State<MorseScreen> {
     _morseSubscription?.cancel();
     _statusSubscription?.cancel();
     _connectionSubscription?.cancel();
+    _progressSubscription?.cancel();
     _reconnectTimer?.cancel();
     super.dispose();
   }
@@ -12,6 +12,13 @@ class BleService {
   BluetoothCharacteristic? morseOutputChar;
   BluetoothCharacteristic? hapticControlChar;
   BluetoothCharacteristic? deviceStatusChar;
+  BluetoothCharacteristic? timingControlChar;
+  BluetoothCharacteristic? progressChar;
+  BluetoothCharacteristic? transferDataChar;
+  BluetoothCharacteristic? transferAckChar;
+  BluetoothCharacteristic? echoFormatChar;
+  BluetoothCharacteristic? alphabetChar;
+  BluetoothCharacteristic? presetChar;
 
   // UUIDs from firmware
   static const String SERVICE_UUID = "19B10000-E8F2-537E-4F6C-D104768A1214";
@@ -22,20 +29,90 @@ class BleService {
       "19B10003-E8F2-537E-4F6C-D104768A1214";
   static const String DEVICE_STATUS_UUID =
       "19B10004-E8F2-537E-4F6C-D104768A1214";
+  static const String TIMING_CONTROL_UUID =
+      "19B10005-E8F2-537E-4F6C-D104768A1214";
+  static const String TRANSFER_DATA_UUID =
+      "19B10006-E8F2-537E-4F6C-D104768A1214";
+  static const String TRANSFER_ACK_UUID =
+      "19B10007-E8F2-537E-4F6C-D104768A1214";
+  static const String ECHO_FORMAT_UUID =
+      "19B10008-E8F2-537E-4F6C-D104768A1214";
+  static const String PLAYBACK_PROGRESS_UUID =
+      "19B10009-E8F2-537E-4F6C-D104768A1214";
+  static const String ALPHABET_UUID = "19B1000A-E8F2-537E-4F6C-D104768A1214";
+  static const String PRESETS_UUID = "19B1000B-E8F2-537E-4F6C-D104768A1214";
+
+  // Presets (see include/preset_store.h in the firmware)
+  static const int PRESET_STORE = 0x01;
+  static const int PRESET_DELETE = 0x02;
+  static const int PRESET_PLAY = 0x03;
+  static const int PRESET_LIST = 0x04;
+  static const int PRESET_OK = 0;
+  static const int PRESET_NOT_FOUND = 1;
+  static const int PRESET_FULL = 2;
+  static const int PRESET_TOO_LARGE = 3;
+  static const int PRESET_EMPTY = 4;
+  static const int PRESET_QUEUE_FULL = 5;
+  static const int PRESET_INVALID = 6;
+  static const int PRESET_STORAGE_ERROR = 7;
+  static const int PRESET_BUSY = 8;  // STORE/DELETE while a message plays
+  // Texts of the presets stored from this app, by id; the device keeps only symbols
+  final Map<int, String> presetTexts = {};
+
+  // Alphabets for non-ASCII text (MorseAlphabet in include/morse_code.h)
+  static const int ALPHABET_LATIN = 0;
+  static const int ALPHABET_CYRILLIC = 1;
+  static const int ALPHABET_GREEK = 2;
+  static const int ALPHABET_WABUN = 3;
+  int alphabet = ALPHABET_LATIN;
+
+  // Morse echo formats (see include/morse_echo.h in the firmware)
+  static const int ECHO_ASCII = 0;
+  static const int ECHO_PACKED = 1;
+  static const int ECHO_DIGEST = 2;
+  static const int ECHO_STREAMED = 0x80;
+  static const int ECHO_CACHE_AWARE = 0x40;
+  static const int ECHO_CHUNK_END = 0x80;
+  static const int ECHO_FLAG_TRUNCATED = 0x01;
+  static const int ECHO_FLAG_CACHED = 0x02;
+  int echoFormat = ECHO_ASCII;
+  bool echoStreamed = false;
+  final List<int> _echoChunks = [];
+
+  // Echoes already rendered, by symbol count and CRC-32, for repeats the device
+  // only sends the digest of
+  static const int ECHO_HISTORY = 32;
+  final Map<int, String> _echoHistory = {};
+
+  // Framed transfer (see include/message_transfer.h in the firmware)
+  static const int TRANSFER_START = 0x01;
+  static const int TRANSFER_DATA = 0x02;
+  static const int TRANSFER_HEADER_SIZE = 4;
+  static const int TRANSFER_IN_PROGRESS = 0;
+  static const int TRANSFER_COMPLETE = 1;
+  static const int TRANSFER_BUSY = 6;  // The last long message is still playing
+  static const int TEXT_INPUT_MAX = 100;
+  final _transferAckController = StreamController<List<int>>.broadcast();
+  int _transferId = 0;
 
   // Stream controllers
   final _morseOutputController = StreamController<String>.broadcast();
   final _deviceStatusController = StreamController<int>.broadcast();
   final _connectionStateController = StreamController<bool>.broadcast();
+  final _progressController = StreamController<PlaybackProgress>.broadcast();
   Stream<String> get morseStream => _morseOutputController.stream;
   Stream<int> get deviceStatusStream => _deviceStatusController.stream;
   Stream<bool> get connectionStream => _connectionStateController.stream;
+  // Letter the device is playing; sent at each letter and at most every 50 ms
+  // within one, so it can drive a highlight directly
+  Stream<PlaybackProgress> get progressStream => _progressController.stream;
 
   // Device status codes
   static const int STATUS_IDLE = 0;
   static const int STATUS_PROCESSING = 1;
   static const int STATUS_PLAYING = 2;
   static const int STATUS_ERROR = 3;
+  static const int STATUS_QUEUE_FULL = 4;  // Message rejected, retry once playback drains
 
   // Scanning
   Future<void> startScan() async {
@@ -71,6 +148,15 @@ class BleService {
           morseOutputChar = null;
           hapticControlChar = null;
           deviceStatusChar = null;
+          timingControlChar = null;
+          progressChar = null;
+          transferDataChar = null;
+          transferAckChar = null;
+          echoFormatChar = null;
+          alphabetChar = null;
+          presetChar = null;
+          echoFormat = ECHO_ASCII;
+          echoStreamed = false;
         }
       });
 
@@ -104,6 +190,15 @@ class BleService {
       morseOutputChar = null;
       hapticControlChar = null;
       deviceStatusChar = null;
+      timingControlChar = null;
+      progressChar = null;
+      transferDataChar = null;
+      transferAckChar = null;
+      echoFormatChar = null;
+      alphabetChar = null;
+      presetChar = null;
+      echoFormat = ECHO_ASCII;
+      echoStreamed = false;
     }
   }
 
@@ -134,6 +229,37 @@ class BleService {
             print('Found device status characteristic');
             deviceStatusChar = characteristic;
             await _setupStatusNotifications(characteristic);
+          } else if (charUuid == TIMING_CONTROL_UUID.toUpperCase()) {
+            print('Found timing control characteristic');
+            timingControlChar = characteristic;
+          } else if (charUuid == TRANSFER_DATA_UUID.toUpperCase()) {
+            print('Found transfer data characteristic');
+            transferDataChar = characteristic;
+          } else if (charUuid == TRANSFER_ACK_UUID.toUpperCase()) {
+            print('Found transfer ack characteristic');
+            transferAckChar = characteristic;
+            await characteristic.setNotifyValue(true);
+            characteristic.onValueReceived.listen(_transferAckController.add);
+          } else if (charUuid == ECHO_FORMAT_UUID.toUpperCase()) {
+            print('Found echo format characteristic');
+            echoFormatChar = characteristic;
+            await setEchoFormat(ECHO_PACKED, streamed: true, cacheAware: true);
+          } else if (charUuid == PLAYBACK_PROGRESS_UUID.toUpperCase()) {
+            print('Found playback progress characteristic');
+            progressChar = characteristic;
+            await characteristic.setNotifyValue(true);
+            characteristic.onValueReceived.listen((value) {
+              if (value.length < 5) return;
+              _progressController.add(PlaybackProgress(
+                  value[0] != 0, value[1], value[2] | value[3] << 8, value[4]));
+            });
+          } else if (charUuid == ALPHABET_UUID.toUpperCase()) {
+            print('Found alphabet characteristic');
+            alphabetChar = characteristic;
+            await setAlphabet(alphabet);
+          } else if (charUuid == PRESETS_UUID.toUpperCase()) {
+            print('Found presets characteristic');
+            presetChar = characteristic;
           }
         }
       }
@@ -146,7 +272,8 @@ class BleService {
       await characteristic.setNotifyValue(true);
       characteristic.onValueReceived.listen(
         (value) {
-          String morse = utf8.decode(value);
+          final morse = _decodeEcho(value);
+          if (morse == null) return;  // More chunks to come
           print('Received morse code: $morse');
           _morseOutputController.add(morse);
         },
@@ -161,6 +288,152 @@ class BleService {
     }
   }
 
+  // Renders any echo format as the dot/dash text the ASCII format carries; null
+  // while a streamed echo is still arriving
+  String? _decodeEcho(List<int> value) {
+    if (echoStreamed) {
+      if (value.isEmpty) return null;
+      if ((value[0] & ECHO_CHUNK_END) == 0) {
+        _echoChunks.addAll(value.skip(1));
+        return null;
+      }
+      if (value.length < 8) return null;
+      final payload = List<int>.from(_echoChunks);
+      _echoChunks.clear();
+      final count = value[2] | value[3] << 8;
+      final key = count << 32 | value[4] | value[5] << 8 | value[6] << 16 | value[7] << 24;
+      if ((value[1] & ECHO_FLAG_CACHED) != 0) {
+        return _echoHistory[key] ?? '$count symbols (repeated)';
+      }
+      final morse = _renderEcho(payload, count, (value[1] & ECHO_FLAG_TRUNCATED) != 0);
+      _echoHistory.remove(key);
+      _echoHistory[key] = morse;
+      if (_echoHistory.length > ECHO_HISTORY) {
+        _echoHistory.remove(_echoHistory.keys.first);
+      }
+      return morse;
+    }
+
+    if (echoFormat == ECHO_ASCII || value.length < 4 || value[0] != echoFormat) {
+      return utf8.decode(value);
+    }
+    return _renderEcho(value.sublist(4), value[2] | value[3] << 8, (value[1] & ECHO_FLAG_TRUNCATED) != 0);
+  }
+
+  String _renderEcho(List<int> payload, int count, bool truncated) {
+    if (echoFormat == ECHO_ASCII) {
+      return utf8.decode(payload);
+    }
+    if (echoFormat == ECHO_DIGEST) {
+      return '$count symbols${truncated ? ' (truncated)' : ''}';
+    }
+
+    const symbols = ['.', '-', ' ', '  '];
+    final morse = StringBuffer();
+    for (var i = 0; i < count && i ~/ 4 < payload.length; i++) {
+      morse.write(symbols[(payload[i ~/ 4] >> ((i % 4) * 2)) & 0x3]);
+    }
+    return morse.toString();
+  }
+
+  // Older firmware has no echo format characteristic and always sends ASCII.
+  // Streamed echoes arrive in chunks of one notification at the current MTU.
+  // With cacheAware (streamed only), repeated messages get only a digest;
+  // firmware without the echo cache rejects the flag, which is then dropped.
+  Future<void> setEchoFormat(int format,
+      {bool streamed = false, bool cacheAware = false}) async {
+    if (echoFormatChar == null) return;
+    final chunkSize = (device?.mtuNow ?? 23) - 3;
+    final aware = cacheAware && streamed;
+    try {
+      await echoFormatChar!.write([
+        format | (streamed ? ECHO_STREAMED : 0) | (aware ? ECHO_CACHE_AWARE : 0),
+        chunkSize & 0xFF,
+        chunkSize >> 8
+      ]);
+      if (aware) {
+        final value = await echoFormatChar!.read();
+        if (value.isEmpty || (value[0] & ECHO_CACHE_AWARE) == 0) {
+          return setEchoFormat(format, streamed: streamed);
+        }
+      }
+      echoFormat = format;
+      echoStreamed = streamed;
+      _echoChunks.clear();
+      print('Set echo format: $format${streamed ? ' (streamed)' : ''}'
+          '${aware ? ', repeats as digests' : ''}');
+    } catch (e) {
+      print('Error setting echo format: $e');
+    }
+  }
+
+  // Alphabet the device reads non-ASCII text with, from the next message on.
+  // Older firmware has no alphabet characteristic and drops non-ASCII text.
+  Future<void> setAlphabet(int value) async {
+    alphabet = value;
+    if (alphabetChar == null) return;
+    try {
+      await alphabetChar!.write([value]);
+      print('Set alphabet: $value');
+    } catch (e) {
+      print('Error setting alphabet: $e');
+    }
+  }
+
+  bool get hasPresets => presetChar != null;
+
+  // Writes one preset command and reads back its result, [op][status][id u16]
+  // or, for PRESET_LIST, [op][status][count][id u16, symbol count u16]...
+  Future<List<int>> _presetCommand(List<int> command) async {
+    if (presetChar == null) {
+      throw StateError('Presets characteristic not available');
+    }
+    await presetChar!.write(command);
+    final result = await presetChar!.read();
+    if (result.length < 2 || result[0] != command[0]) {
+      throw StateError('Unexpected preset result: $result');
+    }
+    return result;
+  }
+
+  // Compiles text into preset `id` on the device with the selected alphabet and
+  // saves it in flash; returns a PRESET_ status
+  Future<int> storePreset(int id, String text) async {
+    final result = await _presetCommand(
+        [PRESET_STORE, id & 0xFF, id >> 8, ...utf8.encode(text)]);
+    if (result[1] == PRESET_OK) presetTexts[id] = text;
+    print('Store preset $id: status ${result[1]}');
+    return result[1];
+  }
+
+  Future<int> deletePreset(int id) async {
+    final result = await _presetCommand([PRESET_DELETE, id & 0xFF, id >> 8]);
+    if (result[1] == PRESET_OK || result[1] == PRESET_NOT_FOUND) {
+      presetTexts.remove(id);
+    }
+    print('Delete preset $id: status ${result[1]}');
+    return result[1];
+  }
+
+  // Plays a stored preset; a one-byte id keeps the write to two bytes
+  Future<int> playPreset(int id) async {
+    final result = await _presetCommand(
+        id < 0x100 ? [PRESET_PLAY, id] : [PRESET_PLAY, id & 0xFF, id >> 8]);
+    print('Play preset $id: status ${result[1]}');
+    return result[1];
+  }
+
+  // Ids of the presets stored on the device
+  Future<List<int>> listPresets() async {
+    final result = await _presetCommand([PRESET_LIST]);
+    final count = result.length > 2 ? result[2] : 0;
+    final ids = <int>[];
+    for (var i = 0; i < count && 3 + i * 4 + 1 < result.length; i++) {
+      ids.add(result[3 + i * 4] | result[4 + i * 4] << 8);
+    }
+    return ids;
+  }
+
   Future<void> _setupStatusNotifications(
       BluetoothCharacteristic characteristic) async {
     try {
@@ -200,6 +473,80 @@ class BleService {
     }
   }
 
+  // Sends text of any length up to the device's limit: short text as one write,
+  // longer text as chunks written without response, with up to `window` chunks
+  // awaiting acknowledgement. Falls back to one write on older firmware.
+  Future<void> sendTextFramed(String text, {int window = 8}) async {
+    final bytes = utf8.encode(text);
+    if (bytes.length <= TEXT_INPUT_MAX ||
+        transferDataChar == null ||
+        transferAckChar == null) {
+      return sendText(text);
+    }
+
+    final mtu = device?.mtuNow ?? 23;
+    final chunkSize = (mtu - 3 - TRANSFER_HEADER_SIZE).clamp(16, 508);
+    final chunkCount = (bytes.length + chunkSize - 1) ~/ chunkSize;
+    final id = _transferId = (_transferId + 1) & 0xFF;
+
+    var acked = 0;
+    var next = 0;
+    var started = false;
+    var status = TRANSFER_IN_PROGRESS;
+    var progress = Completer<void>();
+    final subscription = _transferAckController.stream.listen((ack) {
+      if (ack.length < 4 || ack[0] != id) return;
+      status = ack[1];
+      final nextExpected = ack[2] | ack[3] << 8;
+      if (!started) {
+        started = true;
+      } else if (nextExpected <= acked && next > acked) {
+        next = acked;  // Repeated ack: resend from the missing chunk
+      }
+      if (nextExpected > acked) acked = nextExpected;
+      if (!progress.isCompleted) progress.complete();
+    });
+
+    Future<void> waitForAck() async {
+      await progress.future.timeout(const Duration(milliseconds: 500),
+          onTimeout: () => next = acked);
+      progress = Completer<void>();
+    }
+
+    try {
+      final total = bytes.length;
+      await transferDataChar!.write([
+        TRANSFER_START, id, 0, 0, total & 0xFF, total >> 8,
+        chunkSize & 0xFF, chunkSize >> 8, window
+      ]);
+      while (!started) {
+        await waitForAck();
+      }
+
+      while (status == TRANSFER_IN_PROGRESS) {
+        while (next < chunkCount && next - acked < window) {
+          final start = next * chunkSize;
+          final end = (start + chunkSize).clamp(0, bytes.length);
+          await transferDataChar!.write([
+            TRANSFER_DATA, id, next & 0xFF, next >> 8,
+            ...bytes.sublist(start, end)
+          ], withoutResponse: true);
+          next++;
+        }
+        await waitForAck();
+      }
+      if (status == TRANSFER_BUSY) {
+        throw Exception('Device is still playing the last long message');
+      }
+      if (status != TRANSFER_COMPLETE) {
+        throw Exception('Transfer failed with status $status');
+      }
+      print('Sent ${bytes.length} bytes in $chunkCount chunks');
+    } finally {
+      await subscription.cancel();
+    }
+  }
+
   // Haptic control
   Future<void> setHapticIntensity(int intensity) async {
     if (hapticControlChar == null) {
@@ -217,11 +564,47 @@ class BleService {
     }
   }
 
+  // Morse speed: character WPM, and optional Farnsworth (overall) WPM below it.
+  // Takes effect on the device from the next element, even mid-message.
+  Future<void> setTiming(int wpm, {int farnsworthWpm = 0}) async {
+    if (timingControlChar == null) {
+      print('Cannot set timing: Timing control characteristic not available');
+      return;
+    }
+
+    try {
+      await timingControlChar!.write([wpm, farnsworthWpm]);
+      print('Set timing: $wpm WPM, Farnsworth $farnsworthWpm WPM');
+    } catch (e) {
+      print('Error setting timing: $e');
+      rethrow;
+    }
+  }
+
+  // Effective duration of the last message the device played, in milliseconds
+  Future<int?> readLastMessageDurationMs() async {
+    if (timingControlChar == null) return null;
+    final value = await timingControlChar!.read();
+    if (value.length < 6) return null;
+    return value[2] | value[3] << 8 | value[4] << 16 | value[5] << 24;
+  }
+
   void dispose() {
     print('Disposing BLE service');
     disconnect();
     _morseOutputController.close();
     _deviceStatusController.close();
     _connectionStateController.close();
+    _transferAckController.close();
+    _progressController.close();
   }
 }
+
+class PlaybackProgress {
+  final bool playing;
+  final int message; // Messages finished since playback started
+  final int character; // Byte offset of the letter in that message's UTF-8 text
+  final int symbol; // Element within the letter
+
+  const PlaybackProgress(this.playing, this.message, this.character, this.symbol);
+}
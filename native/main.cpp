@@ -0,0 +1,439 @@
+// Native runner: plays a message through MorseConverter on the virtual clock and
+// checks the resulting LED pulse train against the encoder's symbol stream, then
+// queues messages back to back and checks they are joined by a single word gap,
+// and plays a transfer longer than a queue slot in place. Playback progress is
+// sampled every tick and checked against the text as well. UTF-8 text is encoded
+// in each alphabet and checked against known codes. The echo cache, presets and
+// the device's ingest path have check functions of their own.
+//
+//   pio run -e native && .pio/build/native/program "SOS PARIS"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "echo_cache.h"
+#include "message_ingest.h"
+#include "morse_converter.h"
+#include "morse_echo.h"
+#include "preset_store.h"
+
+static const unsigned long TICK_MS = 1;
+
+static bool countEchoBytes(const uint8_t* data, size_t length, void* context) {
+    (void)data;
+    *static_cast<size_t*>(context) += length;
+    return true;
+}
+
+static void countPlaying(DeviceStatus status, void* context) {
+    *static_cast<size_t*>(context) += status == PLAYING;
+}
+
+// Queues the messages (a nullptr stands for the preset) and plays them out;
+// returns the times of the LED edges
+static std::vector<uint64_t> playQueued(MorseConverter& morse, const char* const* messages, size_t count,
+                                        const MorsePreset* preset) {
+    halReset();
+    halClearTrace();
+    for (size_t i = 0; i < count; i++) {
+        if (messages[i]) {
+            morse.queueText(reinterpret_cast<const uint8_t*>(messages[i]), strlen(messages[i]));
+        } else {
+            morse.queuePacked(preset->packed, preset->symbolCount);
+        }
+    }
+    morse.updatePlayback();
+    while (morse.isPlaybackActive()) {
+        halAdvanceMillis(TICK_MS);
+        morse.updatePlayback();
+    }
+
+    std::vector<uint64_t> edges;
+    for (const HalEvent& event : halTrace()) {
+        if (event.type == HalEventType::DIGITAL_WRITE && event.pin == LED_PIN) {
+            edges.push_back(event.timeUs);
+        }
+    }
+    return edges;
+}
+
+// The echo cache must replay a message's echo byte for byte, tell apart texts that
+// share a hash and evict the least recently used message, but not for a message
+// too long to keep
+static bool checkEchoCache(MorseConverter& morse) {
+    // Messages cached as the echo path does; "message 0" is used again before the
+    // cache fills up, so "message 1" is the one evicted
+    EchoCache echoCache;
+    uint8_t fresh[packedEchoSize(PackedMorse::CAPACITY)];
+    uint8_t replayed[sizeof(fresh)];
+    bool ok = true;
+    for (size_t i = 0; i <= EchoCache::SIZE; i++) {
+        char message[16];
+        const size_t length = snprintf(message, sizeof(message), "message %zu", i);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(message);
+        const uint32_t hash = echoCacheHash(data, length, MorseAlphabet::LATIN);
+        CachedEcho& cached = echoCache.claim(hash, data, length, MorseAlphabet::LATIN);
+        const PackedMorse& packed = morse.textToPackedMorse(message, length);
+        const size_t freshLength = encodePackedEcho(packed, false, fresh, sizeof(fresh));
+        const uint32_t crc = packedMorseCrc32(packed);
+        cached.assign(packed);
+        const CachedEcho* stored = echoCache.commit(cached, false);
+
+        const CachedEcho* hit = echoCache.find(hash, data, length, MorseAlphabet::LATIN);
+        const PackedMorse& loaded = morse.loadPackedMorse(hit->packed, hit->symbolCount, hit->truncated);
+        ok = ok && hit && hit == stored && hit->crc == crc
+             && encodePackedEcho(loaded, false, replayed, sizeof(replayed)) == freshLength
+             && memcmp(fresh, replayed, freshLength) == 0
+             && !echoCache.find(hash, data, length, MorseAlphabet::CYRILLIC);
+
+        // Another text of the same length standing in for a hash collision
+        char other[16];
+        snprintf(other, sizeof(other), "massage %zu", i);
+        ok = ok && !echoCache.find(hash, reinterpret_cast<const uint8_t*>(other), length, MorseAlphabet::LATIN);
+        if (i == 1) {
+            const uint8_t first[] = "message 0";
+            ok = ok && echoCache.find(echoCacheHash(first, 9, MorseAlphabet::LATIN), first, 9, MorseAlphabet::LATIN);
+        }
+    }
+    const uint8_t evicted[] = "message 1";
+    const uint8_t kept[] = "message 0";
+    ok = ok && !echoCache.find(echoCacheHash(evicted, 9, MorseAlphabet::LATIN), evicted, 9, MorseAlphabet::LATIN)
+         && echoCache.find(echoCacheHash(kept, 9, MorseAlphabet::LATIN), kept, 9, MorseAlphabet::LATIN)
+         && echoCache.evictions() == 1 && echoCache.size() == EchoCache::SIZE
+         && echoCache.hits() == EchoCache::SIZE + 3 && echoCache.misses() == 2 * EchoCache::SIZE + 3;
+
+    // A message too long to keep must not push anything out
+    char longMessage[61] = {};
+    memset(longMessage, '0', sizeof(longMessage) - 1);
+    const uint8_t* longData = reinterpret_cast<const uint8_t*>(longMessage);
+    CachedEcho& overflowed = echoCache.claim(echoCacheHash(longData, 60, MorseAlphabet::LATIN), longData, 60,
+                                             MorseAlphabet::LATIN);
+    overflowed.assign(morse.textToPackedMorse(longMessage, 60));
+    ok = ok && !echoCache.commit(overflowed, false) && echoCache.evictions() == 1
+         && echoCache.size() == EchoCache::SIZE
+         && echoCache.find(echoCacheHash(kept, 9, MorseAlphabet::LATIN), kept, 9, MorseAlphabet::LATIN);
+
+    // A digest notice names the same echo as a DIGEST echo, with ECHO_FLAG_CACHED set
+    const CachedEcho* notice = echoCache.find(echoCacheHash(kept, 9, MorseAlphabet::LATIN), kept, 9, MorseAlphabet::LATIN);
+    const size_t noticeLength = encodeCachedEcho(false, false, notice->symbolCount, notice->crc, replayed, sizeof(replayed));
+    encodeDigestEcho(morse.textToPackedMorse("message 0", 9), false, fresh, sizeof(fresh));
+    fresh[1] |= ECHO_FLAG_CACHED;
+    ok = ok && noticeLength == ECHO_DIGEST_SIZE && memcmp(fresh, replayed, ECHO_DIGEST_SIZE) == 0;
+    printf("echo cache: %u hits, %u misses, %u evictions %s\n", echoCache.hits(), echoCache.misses(),
+           echoCache.evictions(), ok ? "OK" : "MISMATCH");
+    return ok;
+}
+
+// A preset, stored and then saved and loaded back as after a restart, must play
+// exactly like its text when queued between two messages
+static bool checkPreset(MorseConverter& morse) {
+    static const char PRESET_TEXT[] = "CQ DE K1ABC";
+    static PresetStore saved;
+    static PresetStore restored;
+    size_t presetSlot = 0;
+    uint8_t image[PresetStore::MAX_IMAGE_SIZE];
+    const PresetStatus presetStatus =
+        saved.store(0x0107, morse.textToPackedMorse(PRESET_TEXT, strlen(PRESET_TEXT)), presetSlot);
+    const bool presetLoaded = restored.loadSlot(presetSlot, image, saved.saveSlot(presetSlot, image, sizeof(image)));
+    const MorsePreset* preset = restored.find(0x0107);
+    const size_t presetSymbols = preset ? preset->symbolCount : 0;
+
+    const char* const asText[] = {"SOS", PRESET_TEXT, "73"};
+    const char* const asPreset[] = {"SOS", nullptr, "73"};
+    const std::vector<uint64_t> textEdges = playQueued(morse, asText, 3, nullptr);
+    const std::vector<uint64_t> presetEdges = preset ? playQueued(morse, asPreset, 3, preset) : std::vector<uint64_t>();
+    size_t removedSlot = 0;
+    const bool ok = presetStatus == PresetStatus::OK && presetLoaded && preset && !textEdges.empty()
+                    && presetEdges == textEdges && restored.remove(0x0107, removedSlot) == PresetStatus::OK
+                    && removedSlot == presetSlot && !restored.find(0x0107);
+    printf("preset: %zu symbols, %zu edges as text, %zu as preset %s\n", presetSymbols,
+           textEdges.size(), presetEdges.size(), ok ? "OK" : "MISMATCH");
+    return ok;
+}
+
+// Messages go through MessageIngest, the device's path for a BLE text write (echo,
+// queue, playback), while heap allocations are counted; there should be none
+static bool checkIngest(MorseConverter& morse) {
+    // Each message is written into one reused buffer, standing in for the
+    // characteristic value, and handed to the MessageIngest the device runs for a
+    // BLE write (echo, queue) before it plays out. Every echo format goes through
+    // it, first encoded and then from the echo cache.
+    static const char* const messages[] = {"CQ CQ DE MORSE", "SOS", "HELLO WORLD 73", "PARIS PARIS"};
+    static const size_t MESSAGE_ROUNDS = 5;
+    struct EchoSetting {
+        EchoFormat format;
+        bool streamed;
+        bool cacheAware;
+    };
+    static const EchoSetting settings[] = {
+        {EchoFormat::ASCII, false, false},  {EchoFormat::PACKED, false, false}, {EchoFormat::DIGEST, false, false},
+        {EchoFormat::PACKED, true, false},  {EchoFormat::DIGEST, true, false},  {EchoFormat::PACKED, false, true},
+    };
+    static const size_t SETTING_COUNT = sizeof(settings) / sizeof(settings[0]);
+    size_t echoBytes = 0;
+    size_t playing = 0;
+    static MessageIngest ingest(morse, countEchoBytes, &echoBytes, countPlaying, &playing);
+    uint8_t value[100];
+    halReset();
+    halSetTraceEnabled(false);
+
+    // The counter must see C allocations too, as Arduino String makes them
+    const uint64_t probeBefore = halAllocations();
+    void* volatile probe = realloc(nullptr, 16);  // volatile: kept even though it is only freed
+    free(probe);
+    const bool probeOk = halAllocations() - probeBefore == 1;
+
+    const uint64_t allocationsBefore = halAllocations();
+    for (const EchoSetting& setting : settings) {
+        ingest.setEchoFormat(setting.format, setting.streamed, ECHO_DEFAULT_CHUNK, setting.cacheAware);
+        for (size_t i = 0; i < MESSAGE_ROUNDS * 4; i++) {
+            const size_t length = strlen(messages[i % 4]);
+            memcpy(value, messages[i % 4], length);
+            ingest.accept(value, length);
+            morse.updatePlayback();
+            while (morse.isPlaybackActive()) {
+                halAdvanceMillis(TICK_MS);
+                morse.updatePlayback();
+            }
+        }
+    }
+    const uint64_t allocations = halAllocations() - allocationsBefore;
+    const size_t messageCount = SETTING_COUNT * MESSAGE_ROUNDS * 4;
+    const bool ok = probeOk && allocations == 0 && playing == messageCount && echoBytes > 0
+                    && ingest.echoCache().hits() > 0;
+    printf("ingestion: %zu messages, %llu heap allocations %s\n", messageCount,
+           static_cast<unsigned long long>(allocations), ok ? "OK" : "MISMATCH");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    const char* text = argc > 1 ? argv[1] : "SOS PARIS";
+
+    MorseConverter morse(5, OutputMode::LED_ONLY);
+    halReset();
+
+    const auto cpuStart = std::chrono::steady_clock::now();
+    unsigned long ticks = 0;
+    std::vector<uint16_t> letters;  // Characters reported, in order
+    std::vector<uint8_t> letterSymbols;
+    ProgressThrottle throttle;
+    size_t notifications = 0;
+    morse.startTextPlayback(text, strlen(text));
+    const uint32_t plannedMs = morse.getMessageDurationMs();
+    while (morse.isPlaybackActive()) {
+        const PlaybackProgress progress = morse.getPlaybackProgress();
+        if (progress.playing && (letters.empty() || letters.back() != progress.character)) {
+            letters.push_back(progress.character);
+            letterSymbols.push_back(0);
+        }
+        if (progress.playing && progress.symbol + 1 > letterSymbols.back()) {
+            letterSymbols.back() = progress.symbol + 1;
+        }
+        notifications += throttle.shouldSend(progress, halMicros() / 1000);
+        halAdvanceMillis(TICK_MS);
+        morse.updatePlayback();
+        ticks++;
+    }
+    notifications += throttle.shouldSend(morse.getPlaybackProgress(), halMicros() / 1000);
+    const double cpuUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - cpuStart).count();
+
+    // LED is active LOW: LOW starts a pulse, HIGH ends it
+    std::vector<unsigned long> onDurations;
+    std::vector<unsigned long> offDurations;
+    uint64_t edge = 0;
+    bool on = false;
+    for (const HalEvent& event : halTrace()) {
+        if (event.type != HalEventType::DIGITAL_WRITE || event.pin != LED_PIN) {
+            continue;
+        }
+        const bool level = event.value == LOW;
+        if (level == on) {
+            continue;
+        }
+        const unsigned long elapsedMs = (event.timeUs - edge) / 1000;
+        if (level) {
+            if (edge > 0) {
+                offDurations.push_back(elapsedMs);
+            }
+        } else {
+            onDurations.push_back(elapsedMs);
+        }
+        edge = event.timeUs;
+        on = level;
+    }
+
+    MorseStreamEncoder encoder;
+    encoder.begin(text);
+    MorseSymbol symbol;
+    std::vector<MorseSymbol> marks;
+    while (encoder.next(symbol)) {
+        if (symbol == MorseSymbol::DOT || symbol == MorseSymbol::DASH) {
+            marks.push_back(symbol);
+        }
+    }
+
+    printf("text: \"%s\"\n", text);
+    printf("pulses: %zu (expected %zu)\n", onDurations.size(), marks.size());
+    printf("message duration: %llu ms (timeline %u ms)\n", static_cast<unsigned long long>(halMicros() / 1000), plannedMs);
+    printf("updatePlayback calls: %lu, host CPU: %.1f us (%.1f ns/call)\n", ticks, cpuUs, cpuUs * 1000 / ticks);
+
+    bool ok = onDurations.size() == marks.size() && !marks.empty();
+    unsigned long dot = 0;
+    unsigned long dash = 0;
+    for (size_t i = 0; ok && i < marks.size(); i++) {
+        unsigned long& expected = marks[i] == MorseSymbol::DOT ? dot : dash;
+        if (expected == 0) {
+            expected = onDurations[i];
+        }
+        ok = onDurations[i] == expected;
+    }
+    ok = ok && (dash == 0 || dot == 0 || dash == 3 * dot);
+    ok = ok && halMicros() / 1000 == plannedMs;
+
+    printf("dot %lu ms, dash %lu ms, gaps:", dot, dash);
+    for (unsigned long gap : offDurations) {
+        printf(" %lu", gap);
+    }
+    printf("\ntiming %s\n", ok ? "OK" : "MISMATCH");
+
+    // Every mapped character in order, each with all of its elements. Both letters
+    // of a two-letter character report its offset, so they count as one here.
+    std::vector<uint16_t> expectedLetters;
+    std::vector<uint8_t> expectedSymbols;
+    for (size_t i = 0; text[i];) {
+        uint32_t codePoint;
+        const size_t used = decodeUtf8(text + i, SIZE_MAX, codePoint);
+        PackedCode code = packedCodeFor(text[i]);
+        if (codePoint >= 0x80) {
+            const MorseGlyphEntry* glyph = morseGlyphFor(codePoint, morse.getAlphabet());
+            code = {0, 0};
+            for (int j = 0; glyph && j < MORSE_GLYPH_LETTERS; j++) {
+                code.length = glyph->letters[j].length > code.length ? glyph->letters[j].length : code.length;
+            }
+        }
+        if (text[i] != ' ' && code.length) {
+            expectedLetters.push_back(i);
+            expectedSymbols.push_back(code.length);
+        }
+        i += used;
+    }
+    const size_t notificationLimit = expectedLetters.size() + plannedMs / PROGRESS_MIN_INTERVAL_MS + 1;
+    const bool progressOk = letters == expectedLetters && letterSymbols == expectedSymbols
+                            && notifications <= notificationLimit && !morse.getPlaybackProgress().playing;
+    printf("progress: %zu letters, %zu notifications (limit %zu) %s\n", letters.size(), notifications,
+           notificationLimit, progressOk ? "OK" : "MISMATCH");
+
+    // Alternate "E" and "T" into the queue while idle; playback starts on the next
+    // updatePlayback() and the messages beyond the queue depth are rejected. The
+    // error blink a rejection asks for mid-playback must not be left pending.
+    halReset();
+    halClearTrace();
+    const size_t offered = MessageQueue::DEPTH + 2;
+    size_t accepted = 0;
+    uint32_t expectedUnits = 0;
+    for (size_t i = 0; i < offered; i++) {
+        const char* message = i % 2 ? "T" : "E";
+        if (morse.queueText(reinterpret_cast<const uint8_t*>(message), 1)) {
+            expectedUnits += (i % 2 ? DASH_UNITS : DOT_UNITS) + (accepted ? WORD_GAP_UNITS : 0);
+            accepted++;
+        }
+    }
+    morse.updatePlayback();
+    morse.indicateError();
+    uint8_t lastMessage = 0;
+    while (morse.isPlaybackActive()) {
+        lastMessage = morse.getPlaybackProgress().message;
+        halAdvanceMillis(TICK_MS);
+        morse.updatePlayback();
+    }
+    const uint32_t queuedMs = morse.getMessageDurationMs();  // Grows as queued messages are chained
+    const uint32_t expectedMs = expectedUnits * 100;
+    const bool queueOk = accepted == MessageQueue::DEPTH && morse.queuedMessages() == 0
+                         && halMicros() / 1000 == expectedMs && queuedMs == expectedMs
+                         && lastMessage == accepted - 1 && !morse.isStatusPatternActive();
+    printf("queue: %zu of %zu accepted, %llu ms (expected %u ms) %s\n", accepted, offered,
+           static_cast<unsigned long long>(halMicros() / 1000), expectedMs, queueOk ? "OK" : "MISMATCH");
+
+    // A transfer longer than a queue slot plays in full from its own buffer, which
+    // stays borrowed until playback is done with it
+    static uint8_t transfer[MessageQueue::MAX_LENGTH * 3 - 1];
+    for (size_t i = 0; i < sizeof(transfer); i++) {
+        transfer[i] = i % 2 ? ' ' : 'E';
+    }
+    const size_t transferLetters = (sizeof(transfer) + 1) / 2;
+    halReset();
+    bool transferOk = morse.queueTransfer(transfer, sizeof(transfer)) && morse.isQueued(transfer);
+    morse.updatePlayback();
+    while (morse.isPlaybackActive()) {
+        halAdvanceMillis(TICK_MS);
+        morse.updatePlayback();
+    }
+    transferOk = transferOk && !morse.isQueued(transfer)
+                 && halMicros() / 1000 == (transferLetters * DOT_UNITS + (transferLetters - 1) * WORD_GAP_UNITS) * 100;
+    printf("transfer: %zu bytes, %llu ms %s\n", sizeof(transfer), static_cast<unsigned long long>(halMicros() / 1000),
+           transferOk ? "OK" : "MISMATCH");
+
+    // Own codes, transliterations, lowercase and hiragana folding, two-letter
+    // characters, a code point outside the selected alphabet and a cut-off sequence
+    struct AlphabetCase {
+        MorseAlphabet alphabet;
+        const char* text;
+        const char* morse;
+    };
+    static const AlphabetCase alphabetCases[] = {
+        {MorseAlphabet::LATIN, "\u00c7a \u00e9", "-.-.. .-  ..-.."},
+        {MorseAlphabet::LATIN, "\u00df\u00ed", "... ... .."},
+        {MorseAlphabet::CYRILLIC, "\u041c\u0438\u0440", "-- .. .-."},
+        {MorseAlphabet::GREEK, "\u03a9\u03bc\u03ad\u03b3\u03b1", ".-- -- . --. .-"},
+        {MorseAlphabet::WABUN, "\u30ac\u3063", ".-.. .. .--."},
+        {MorseAlphabet::CYRILLIC, "\u00c4E", " ."},
+        {MorseAlphabet::LATIN, "\xc3" "E", " ."},
+    };
+    bool alphabetOk = true;
+    for (const AlphabetCase& c : alphabetCases) {
+        char out[64];
+        const MorseEncodeResult result = encodeMorse(c.text, out, sizeof(out), c.alphabet);
+        const bool match = strcmp(out, c.morse) == 0 && result.length == morseEncodedLength(c.text, c.alphabet);
+        if (!match) {
+            printf("alphabet %u: \"%s\" encoded as \"%s\", expected \"%s\"\n",
+                   static_cast<unsigned>(c.alphabet), c.text, out, c.morse);
+        }
+        alphabetOk = alphabetOk && match;
+    }
+
+    // Queued in Wabun: both letters of the voiced kana play, at its byte offset
+    static const char kana[] = "\u30ab\u30ac";  // KA GA: .-.. then .-.. ..
+    morse.setAlphabet(MorseAlphabet::WABUN);
+    morse.queueText(reinterpret_cast<const uint8_t*>(kana), strlen(kana));
+    morse.setAlphabet(MorseAlphabet::LATIN);
+    halReset();
+    halClearTrace();
+    morse.updatePlayback();
+    std::vector<uint16_t> kanaLetters;
+    while (morse.isPlaybackActive()) {
+        const PlaybackProgress progress = morse.getPlaybackProgress();
+        if (progress.playing && (kanaLetters.empty() || kanaLetters.back() != progress.character)) {
+            kanaLetters.push_back(progress.character);
+        }
+        halAdvanceMillis(TICK_MS);
+        morse.updatePlayback();
+    }
+    size_t kanaMarks = 0;
+    bool kanaOn = false;
+    for (const HalEvent& event : halTrace()) {
+        if (event.type == HalEventType::DIGITAL_WRITE && event.pin == LED_PIN && (event.value == LOW) != kanaOn) {
+            kanaOn = !kanaOn;
+            kanaMarks += kanaOn;
+        }
+    }
+    alphabetOk = alphabetOk && kanaMarks == 10 && kanaLetters == std::vector<uint16_t>{0, 3};
+    printf("alphabets: %zu cases, kana %zu marks %s\n", sizeof(alphabetCases) / sizeof(alphabetCases[0]),
+           kanaMarks, alphabetOk ? "OK" : "MISMATCH");
+
+    const bool cacheOk = checkEchoCache(morse);
+    const bool presetOk = checkPreset(morse);
+    const bool allocationOk = checkIngest(morse);
+
+    return ok && progressOk && queueOk && transferOk && alphabetOk && cacheOk && presetOk && allocationOk ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+"""Generates include/morse_alphabet.h from morse_alphabet.csv, the one definition of the alphabet,
+and include/morse_unicode_tables.h from the non-ASCII alphabets in alphabets/.
+
+Runs before every PlatformIO build, or by hand:
+
+    python3 scripts/gen_morse_tables.py [--check]
+
+Each CSV row is `character, code`. A character is a single byte, quoted when it is
+a comma or double quote. Prosigns have no character of their own, so they are
+written `<NAME>, code, byte` and sent or decoded as that byte (an ASCII control
+code). Headers are rewritten only when their contents change. --check fails instead
+of writing, for catching a stale header.
+
+Each alphabets/*.csv row is `character, code` for one non-ASCII code point. The code
+is dots and dashes, or a character of the same CSV or morse_alphabet.csv whose code
+it borrows (transliteration, e.g. `Á, A`). Up to two space-separated parts send two
+letters, as Wabun does for voiced kana (`ガ, カ ゛`). Lowercase forms, and hiragana
+for katakana, are added automatically.
+"""
+import argparse
+import csv
+import os
+import sys
+
+CSV_NAME = "morse_alphabet.csv"
+HEADER_PATH = os.path.join("include", "morse_alphabet.h")
+# PackedCode holds 8 symbols, but host/morse_bulk_encoder.cpp writes a code and its
+# separator as one 8-byte slot and two of them as one PAIR_SLOT_SIZE (16-byte) store
+MAX_CODE_LENGTH = 7
+UNMAPPED = 0xFF
+
+ALPHABET_DIR = "alphabets"
+UNICODE_HEADER_PATH = os.path.join("include", "morse_unicode_tables.h")
+# MorseAlphabet enumerators and their tables; ASCII always uses morse_alphabet.csv
+ALPHABETS = (("LATIN", "latin.csv"), ("CYRILLIC", "cyrillic.csv"), ("GREEK", "greek.csv"), ("WABUN", "wabun.csv"))
+MAX_GLYPH_LETTERS = 2
+KATAKANA = range(0x30A1, 0x30F7)  # Letters whose hiragana sits 0x60 below
+
+
+class AlphabetError(Exception):
+    pass
+
+
+def load_alphabet(path: str) -> list:
+    """(byte, name, code) for each CSV row, in file order"""
+    entries = []
+    with open(path, newline="") as file:
+        rows = csv.reader(file, skipinitialspace=True)
+        next(rows)  # Header
+        for line, row in enumerate(rows, start=2):
+            if not row:
+                continue
+            name, code = row[0], row[1].strip()
+            if name.startswith("<") and name.endswith(">"):
+                if len(row) < 3:
+                    raise AlphabetError(f"{CSV_NAME}:{line}: prosign {name} needs a byte")
+                byte = int(row[2], 0)
+            elif len(name) == 1:
+                byte = ord(name)
+            else:
+                raise AlphabetError(f"{CSV_NAME}:{line}: '{name}' is not one character or a <PROSIGN>")
+
+            if not code or set(code) - set(".-"):
+                raise AlphabetError(f"{CSV_NAME}:{line}: '{code}' is not a dot/dash code")
+            if len(code) > MAX_CODE_LENGTH:
+                raise AlphabetError(f"{CSV_NAME}:{line}: {name} is longer than {MAX_CODE_LENGTH} symbols, the most the "
+                                    f"PAIR_SLOT_SIZE slots of host/morse_bulk_encoder.cpp hold")
+            if byte in (0, ord(" "), UNMAPPED) or byte > 0x7F:
+                raise AlphabetError(f"{CSV_NAME}:{line}: {name} cannot use byte {byte:#04x}")
+            entries.append((byte, name, code))
+
+    for kind, column in (("character", 0), ("code", 2)):
+        seen = {}
+        for entry in entries:
+            if entry[column] in seen:
+                raise AlphabetError(f"{CSV_NAME}: {entry[1]} repeats the {kind} of {seen[entry[column]]}")
+            seen[entry[column]] = entry[1]
+    if len(entries) >= UNMAPPED:
+        raise AlphabetError(f"{CSV_NAME}: too many entries for an 8-bit index")
+    return entries
+
+
+def char_literal(byte: int) -> str:
+    if byte == 0:
+        return "0"
+    if byte in (ord("'"), ord("\\")):
+        return f"'\\{chr(byte)}'"
+    if 0x20 <= byte < 0x7F:
+        return f"'{chr(byte)}'"
+    return f"'\\x{byte:02x}'"
+
+
+def pack(code: str) -> tuple:
+    """Length and dash bits, LSB first, as in PackedCode"""
+    return len(code), sum(1 << i for i, symbol in enumerate(code) if symbol == "-")
+
+
+def rows_of(items: list, per_row: int, width: int = 0) -> str:
+    """Comma-separated items, per_row to a line; width pads each one to line up columns"""
+    cells = [f"{item}," for item in items[:-1]] + items[-1:]
+    lines = []
+    for i in range(0, len(cells), per_row):
+        row = cells[i:i + per_row]
+        lines.append("    " + " ".join([cell.ljust(width) for cell in row[:-1]] + row[-1:]))
+    return "\n".join(lines)
+
+
+def render(entries: list) -> str:
+    longest = max(len(code) for _, _, code in entries)
+
+    index = [UNMAPPED] * 256
+    for i, (byte, _, _) in enumerate(entries):
+        index[byte] = i
+        if ord("A") <= byte <= ord("Z"):
+            index[byte - ord("A") + ord("a")] = i  # Lowercase folds onto uppercase
+
+    # Implicit dichotomic tree: root at 1, dot -> 2n, dash -> 2n + 1
+    tree = [0] * (2 << longest)
+    for byte, _, code in entries:
+        node = 1
+        for symbol in code:
+            node = 2 * node + (symbol == "-")
+        tree[node] = byte
+
+    table = [f'{{{char_literal(byte)}, "{code}"}}' for byte, _, code in entries]
+    packed = ["{%d, 0x%02x}" % pack(code) for _, _, code in entries]
+    prosigns = [f"{name} = {char_literal(byte)}" for byte, name, _ in entries if name.startswith("<")]
+
+    return f"""// Generated by scripts/gen_morse_tables.py from {CSV_NAME}; edit the CSV, not this file.
+// Included from morse_code.h. Everything here is constant data, so on the ESP32 it
+// stays in flash, and inline constexpr keeps one copy however many files use it.
+#pragma once
+
+// Prosigns, sent and decoded as control bytes: {", ".join(prosigns) or "none"}
+
+constexpr int MORSE_TABLE_SIZE = {len(entries)};
+inline constexpr MorseEntry MORSE_TABLE[MORSE_TABLE_SIZE] = {{
+{rows_of(table, 5, max(len(item) for item in table) + 1)}
+}};
+
+constexpr int MORSE_MAX_CODE_LENGTH = {longest};
+
+struct MorsePackedTable {{
+    PackedCode entry[MORSE_TABLE_SIZE];
+}};
+
+// Parallel to MORSE_TABLE, indexed through MORSE_ENCODE_INDEX
+inline constexpr MorsePackedTable MORSE_PACKED_TABLE = {{{{
+{rows_of(packed, 8)}
+}}}};
+
+// Direct byte -> MORSE_TABLE index lookup, lowercase letters fold onto uppercase
+inline constexpr MorseEncodeIndex MORSE_ENCODE_INDEX = {{{{
+{rows_of([f"0x{i:02x}" for i in index], 16)}
+}}}};
+
+// Dichotomic decode tree in implicit array layout: root at 1, dot -> 2n, dash -> 2n + 1.
+// Nodes without a character hold 0.
+constexpr int MORSE_DECODE_TREE_SIZE = 2 << MORSE_MAX_CODE_LENGTH;
+
+struct MorseDecodeTree {{
+    char node[MORSE_DECODE_TREE_SIZE];
+}};
+
+inline constexpr MorseDecodeTree MORSE_DECODE_TREE = {{{{
+{rows_of([char_literal(b) for b in tree], 16)}
+}}}};
+"""
+
+
+def load_unicode_alphabet(path: str, base: dict) -> dict:
+    """code point -> tuple of codes (one per letter sent), lowercase and hiragana included"""
+    name = os.path.join(ALPHABET_DIR, os.path.basename(path))
+    rows = []
+    with open(path, newline="", encoding="utf-8") as file:
+        reader = csv.reader(file, skipinitialspace=True)
+        next(reader)  # Header
+        for line, row in enumerate(reader, start=2):
+            if not row:
+                continue
+            char, parts = row[0], row[1].split()
+            if len(char) != 1 or not 0x80 <= ord(char) <= 0xFFFF:
+                raise AlphabetError(f"{name}:{line}: '{char}' is not one non-ASCII character in the BMP")
+            if not 1 <= len(parts) <= MAX_GLYPH_LETTERS:
+                raise AlphabetError(f"{name}:{line}: {char} needs 1 to {MAX_GLYPH_LETTERS} letters")
+            rows.append((line, char, parts))
+
+    own = {char: parts[0] for _, char, parts in rows if len(parts) == 1 and not set(parts[0]) - set(".-")}
+    glyphs = {}
+    for line, char, parts in rows:
+        codes = []
+        for part in parts:
+            code = part if not set(part) - set(".-") else own.get(part, base.get(part))
+            if code is None:
+                raise AlphabetError(f"{name}:{line}: {char} borrows from '{part}', which has no code of its own")
+            if len(code) > MAX_CODE_LENGTH:
+                raise AlphabetError(f"{name}:{line}: {char} is longer than {MAX_CODE_LENGTH} symbols, the most the "
+                                    f"PAIR_SLOT_SIZE slots of host/morse_bulk_encoder.cpp hold")
+            codes.append(code)
+        if ord(char) in glyphs:
+            raise AlphabetError(f"{name}:{line}: {char} is listed twice")
+        glyphs[ord(char)] = tuple(codes)
+
+    for point, codes in list(glyphs.items()):
+        folds = [chr(point).lower()] + ([chr(point - 0x60)] if point in KATAKANA else [])
+        for fold in folds:
+            if len(fold) == 1 and ord(fold) >= 0x80:
+                glyphs.setdefault(ord(fold), codes)
+    return glyphs
+
+
+def render_unicode(alphabets: list) -> str:
+    """alphabets: (enumerator, glyphs) in MorseAlphabet order"""
+    owner = {}
+    for enumerator, glyphs in alphabets:
+        for point in glyphs:
+            if point in owner:
+                raise AlphabetError(f"U+{point:04X} is in both {owner[point]} and {enumerator}")
+            owner[point] = enumerator
+
+    # One entry per distinct (alphabet, letters); code points index into it through pages
+    entries, entry_of, page_of = [], {}, {}
+    for enumerator, glyphs in alphabets:
+        for point, codes in sorted(glyphs.items()):
+            key = (enumerator, codes)
+            if key not in entry_of:
+                entry_of[key] = len(entries)
+                entries.append(key)
+            page_of.setdefault(point >> 8, [UNMAPPED] * 256)[point & 0xFF] = entry_of[key]
+    if len(entries) >= UNMAPPED:
+        raise AlphabetError("too many Unicode glyphs for an 8-bit index")
+
+    pages = sorted(page_of)
+    page_index = [UNMAPPED] * 256
+    for i, page in enumerate(pages):
+        page_index[page] = i
+
+    def glyph(enumerator, codes):
+        letters = ["{%d, 0x%02x}" % pack(code) for code in codes] + ["{0, 0}"] * (MAX_GLYPH_LETTERS - len(codes))
+        return f"{{MorseAlphabet::{enumerator}, {{{', '.join(letters)}}}}}"
+
+    counts = ", ".join(f"{enumerator} {len(glyphs)}" for enumerator, glyphs in alphabets)
+    def page_table(page):
+        cells = "    " + rows_of([f"0x{i:02x}" for i in page_of[page]], 16).replace("\n", "\n    ")
+        return f"    {{{{  // U+{page:02X}00\n{cells}\n    }}}}"
+
+    page_tables = ",\n".join(page_table(page) for page in pages)
+
+    return f"""// Generated by scripts/gen_morse_tables.py from {ALPHABET_DIR}/*.csv; edit the CSVs, not this file.
+// Included from morse_encoder.cpp only. Constant data, so on the ESP32 it stays in flash.
+#pragma once
+
+// Code points per alphabet: {counts}
+
+constexpr int MORSE_GLYPH_COUNT = {len(entries)};
+inline constexpr MorseGlyphEntry MORSE_GLYPHS[MORSE_GLYPH_COUNT] = {{
+{rows_of([glyph(*entry) for entry in entries], 2)}
+}};
+
+// Code point >> 8 -> MORSE_UNICODE_PAGES index, for the Basic Multilingual Plane
+inline constexpr MorseEncodeIndex MORSE_UNICODE_PAGE_INDEX = {{{{
+{rows_of([f"0x{i:02x}" for i in page_index], 16)}
+}}}};
+
+// Code point & 0xFF -> MORSE_GLYPHS index, one table per page in use
+constexpr int MORSE_UNICODE_PAGE_COUNT = {len(pages)};
+inline constexpr MorseEncodeIndex MORSE_UNICODE_PAGES[MORSE_UNICODE_PAGE_COUNT] = {{
+{page_tables}
+}};
+"""
+
+
+def write_header(root: str, path: str, text: str, source: str, check: bool) -> int:
+    full = os.path.join(root, path)
+    current = open(full, encoding="utf-8").read() if os.path.exists(full) else None
+    if current == text:
+        return 0
+    if check:
+        print(f"gen_morse_tables: {path} is out of date with {source}")
+        return 1
+    with open(full, "w", encoding="utf-8") as file:
+        file.write(text)
+    print(f"gen_morse_tables: wrote {path}")
+    return 0
+
+
+def generate(root: str, check: bool) -> int:
+    try:
+        entries = load_alphabet(os.path.join(root, CSV_NAME))
+        base = {name: code for _, name, code in entries if len(name) == 1}
+        alphabets = [(enumerator, load_unicode_alphabet(os.path.join(root, ALPHABET_DIR, csv_name), base))
+                     for enumerator, csv_name in ALPHABETS]
+        text = render(entries)
+        unicode_text = render_unicode(alphabets)
+    except (AlphabetError, OSError, ValueError, IndexError) as error:
+        print(f"gen_morse_tables: {error}")
+        return 1
+
+    return (write_header(root, HEADER_PATH, text, CSV_NAME, check)
+            | write_header(root, UNICODE_HEADER_PATH, unicode_text, f"{ALPHABET_DIR}/*.csv", check))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=f"Generate the Morse table headers from {CSV_NAME} and {ALPHABET_DIR}/")
+    parser.add_argument("--check", action="store_true", help="fail if a header is out of date")
+    args = parser.parse_args()
+    sys.exit(generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), args.check))
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    if generate(env.subst("$PROJECT_DIR"), False):  # noqa: F821
+        env.Exit(1)  # noqa: F821
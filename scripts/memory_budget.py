@@ -0,0 +1,102 @@
+"""Static RAM report for the firmware's message path.
+
+Runs after the firmware links as a PlatformIO extra script, or by hand on object files:
+
+    python3 scripts/memory_budget.py [--nm nm] [--budget BYTES] [--static] build/src/*.o
+
+Covers the firmware's own objects, whose globals hold the message pools (queue,
+transfer buffer, echo buffer, timeline); library internals are not included. The
+report lists each object's .bss/.data and its largest buffers. With
+MORSE_STATIC_MEMORY the build fails if any of them calls the heap, and with
+MORSE_RAM_BUDGET if their total exceeds it.
+"""
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+
+# Undefined symbols that mean heap use: C allocators, operator new/new[] and Arduino String
+HEAP_SYMBOL = re.compile(r"^(malloc|calloc|realloc|strdup|strndup|heap_caps_\w*alloc|pvPortMalloc|_Znw|_Zna|_ZN6String)")
+RAM_TYPES = "bBdD"
+TOP_SYMBOLS = 3
+
+
+def nm_lines(nm: str, args: list) -> list:
+    return subprocess.run([nm] + args, check=True, capture_output=True, text=True).stdout.splitlines()
+
+
+def object_ram(nm: str, path: str) -> list:
+    """(size, name) of each symbol the object places in RAM, largest first"""
+    symbols = []
+    for line in nm_lines(nm, ["-S", "-C", "--size-sort", path]):
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in RAM_TYPES:
+            symbols.append((int(fields[1], 16), fields[3]))
+    return sorted(symbols, reverse=True)
+
+
+def heap_calls(nm: str, path: str) -> list:
+    calls = []
+    for line in nm_lines(nm, ["-u", path]):
+        symbol = line.split()[-1]
+        if HEAP_SYMBOL.match(symbol):
+            calls.append(symbol)
+    return calls
+
+
+def report(nm: str, objects: list, budget: int, static: bool) -> int:
+    """Prints the report; returns the number of problems found"""
+    problems = 0
+    total = 0
+    print("RAM budget (firmware objects):")
+    for path in sorted(objects):
+        name = os.path.basename(path).replace(".o", "")
+        symbols = object_ram(nm, path)
+        size = sum(s for s, _ in symbols)
+        total += size
+        largest = ", ".join(f"{symbol} {s}" for s, symbol in symbols[:TOP_SYMBOLS])
+        print(f"  {name:<24} {size:>7} B  {largest}")
+
+        for symbol in heap_calls(nm, path):
+            print(f"  error: {name} uses the heap ({symbol})" if static else f"  note: {name} uses the heap ({symbol})")
+            problems += static
+
+    print(f"  {'total':<24} {total:>7} B" + (f" of {budget} B budget" if budget else ""))
+    if budget and total > budget:
+        print(f"  error: static RAM is {total - budget} B over MORSE_RAM_BUDGET")
+        problems += 1
+    return problems
+
+
+def define_value(env, name: str):
+    """Value of a -D flag from the PlatformIO environment; True if it has none, None if unset"""
+    for define in env.get("CPPDEFINES", []):
+        if isinstance(define, (tuple, list)) and define[0] == name:
+            return define[1]
+        if define == name:
+            return True
+    return None
+
+
+def after_link(source, target, env):
+    nm = re.sub(r"gcc$", "nm", env.subst("$CC"))
+    objects = glob.glob(os.path.join(env.subst("$BUILD_DIR"), "src", "*.o"))
+    budget = define_value(env, "MORSE_RAM_BUDGET")
+    problems = report(nm, objects, int(budget) if budget not in (None, True) else 0,
+                      define_value(env, "MORSE_STATIC_MEMORY") is not None)
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Static RAM report for the message path")
+    parser.add_argument("objects", nargs="+")
+    parser.add_argument("--nm", default="nm")
+    parser.add_argument("--budget", type=int, default=0)
+    parser.add_argument("--static", action="store_true", help="fail on heap use")
+    args = parser.parse_args()
+    sys.exit(1 if report(args.nm, args.objects, args.budget, args.static) else 0)
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", after_link)  # noqa: F821
@@ -0,0 +1,122 @@
+#include "echo_cache.h"
+#include <string.h>
+#include "morse_echo.h"
+
+static const uint32_t FNV_OFFSET = 2166136261u;
+static const uint32_t FNV_PRIME = 16777619u;
+
+uint32_t echoCacheHash(const uint8_t* data, size_t length, MorseAlphabet alphabet) {
+    uint32_t hash = (FNV_OFFSET ^ static_cast<uint8_t>(alphabet)) * FNV_PRIME;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+void CachedEcho::add(MorseSymbol symbol) {
+    if (symbolCount >= MORSE_ECHO_CACHE_SYMBOLS) {
+        overflow = true;
+        return;
+    }
+
+    const size_t byte = symbolCount >> 2;
+    const uint8_t shift = (symbolCount & 3) * 2;
+    packed[byte] = (packed[byte] & ~(0x3 << shift)) | (static_cast<uint8_t>(symbol) << shift);
+    symbolCount++;
+}
+
+void CachedEcho::assign(const PackedMorse& morse) {
+    if (morse.length() > MORSE_ECHO_CACHE_SYMBOLS) {
+        overflow = true;
+        return;
+    }
+    memcpy(packed, morse.bytes(), (morse.length() + 3) / 4);
+    symbolCount = morse.length();
+}
+
+MorseSymbol CachedEcho::at(size_t index) const {
+    return packedSymbolAt(packed, index);
+}
+
+CachedEcho* EchoCache::find(uint32_t hash, const uint8_t* data, size_t length, MorseAlphabet alphabet) {
+    for (CachedEcho& echo : entries) {
+        if (echo.lastUsed != 0 && echo.hash == hash && echo.textLength == length && echo.alphabet == alphabet
+            && memcmp(echo.text, data, length) == 0) {
+            echo.lastUsed = ++useClock;
+            hitCount++;
+            return &echo;
+        }
+    }
+    missCount++;
+    return nullptr;
+}
+
+CachedEcho& EchoCache::claim(uint32_t hash, const uint8_t* data, size_t length, MorseAlphabet alphabet) {
+    scratch.hash = hash;
+    scratch.textLength = static_cast<uint16_t>(length);
+    scratch.alphabet = alphabet;
+    scratch.truncated = false;
+    scratch.sent = false;
+    scratch.overflow = length > MORSE_ECHO_CACHE_TEXT;
+    if (!scratch.overflow) {
+        memcpy(scratch.text, data, length);
+    }
+    scratch.symbolCount = 0;
+    scratch.lastUsed = 0;
+    return scratch;
+}
+
+const CachedEcho* EchoCache::commit(const CachedEcho& echo, bool truncated) {
+    // An echo that does not fit leaves every stored one in place
+    if (echo.overflow || echo.symbolCount == 0) {
+        return nullptr;
+    }
+
+    CachedEcho* victim = &entries[0];
+    for (CachedEcho& entry : entries) {
+        if (entry.lastUsed < victim->lastUsed) {
+            victim = &entry;
+        }
+    }
+    if (victim->lastUsed != 0) {
+        evictionCount++;
+    }
+
+    *victim = echo;
+    victim->truncated = truncated;
+    victim->crc = packedMorseCrc32(victim->packed, victim->symbolCount);
+    victim->lastUsed = ++useClock;
+    return victim;
+}
+
+void EchoCache::forgetSent() {
+    for (CachedEcho& echo : entries) {
+        echo.sent = false;
+    }
+}
+
+void EchoCache::clear() {
+    for (CachedEcho& echo : entries) {
+        echo.lastUsed = 0;
+    }
+}
+
+uint32_t EchoCache::hits() const {
+    return hitCount;
+}
+
+uint32_t EchoCache::misses() const {
+    return missCount;
+}
+
+uint32_t EchoCache::evictions() const {
+    return evictionCount;
+}
+
+size_t EchoCache::size() const {
+    size_t count = 0;
+    for (const CachedEcho& echo : entries) {
+        count += echo.lastUsed != 0;
+    }
+    return count;
+}
@@ -1,6 +1,14 @@
 #include <Arduino.h>
 #include <ArduinoBLE.h>
+#include <Preferences.h>
+#include <esp_freertos_hooks.h>
+#include <freertos/stream_buffer.h>
+#include "echo_cache.h"
+#include "message_ingest.h"
+#include "message_transfer.h"
 #include "morse_converter.h"
+#include "morse_echo.h"
+#include "preset_store.h"
 
 // BLE UUIDs - must match Flutter app
 #define MORSE_SERVICE_UUID        "19B10000-E8F2-537E-4F6C-D104768A1214"
@@ -8,38 +16,207 @@
 #define MORSE_OUTPUT_UUID        "19B10002-E8F2-537E-4F6C-D104768A1214"
 #define HAPTIC_CONTROL_UUID      "19B10003-E8F2-537E-4F6C-D104768A1214"
 #define DEVICE_STATUS_UUID       "19B10004-E8F2-537E-4F6C-D104768A1214"
+#define TIMING_CONTROL_UUID      "19B10005-E8F2-537E-4F6C-D104768A1214"
+#define TRANSFER_DATA_UUID       "19B10006-E8F2-537E-4F6C-D104768A1214"
+#define TRANSFER_ACK_UUID        "19B10007-E8F2-537E-4F6C-D104768A1214"
+#define ECHO_FORMAT_UUID         "19B10008-E8F2-537E-4F6C-D104768A1214"
+#define PLAYBACK_PROGRESS_UUID   "19B10009-E8F2-537E-4F6C-D104768A1214"
+#define ALPHABET_UUID            "19B1000A-E8F2-537E-4F6C-D104768A1214"
+#define PRESETS_UUID             "19B1000B-E8F2-537E-4F6C-D104768A1214"
 
 // Pin definitions
 const int VIBRATION_PIN = 5;  // GPIO6 for D6 on XIAO ESP32S3
 const int DEFAULT_HAPTIC_INTENSITY = 128;  // 50% intensity
+const int TEXT_INPUT_MAX = MORSE_MESSAGE_MAX < 100 ? MORSE_MESSAGE_MAX : 100;  // textInputChar value size; longer text uses the transfer characteristics
+const int PRESET_VALUE_MAX = 3 + TEXT_INPUT_MAX > (int)PresetStore::MAX_LIST_SIZE ? 3 + TEXT_INPUT_MAX : PresetStore::MAX_LIST_SIZE;  // STORE write or LIST result
+const char PRESET_NAMESPACE[] = "presets";  // NVS namespace, one blob per preset slot
 
-// Status codes - must match Flutter app
-enum DeviceStatus {
-    IDLE = 0,
-    PROCESSING = 1,
-    PLAYING = 2,
-    ERROR = 3
+// Playback runs in its own task on the core loop() does not use
+#ifdef ARDUINO_RUNNING_CORE
+const BaseType_t LOOP_CORE = ARDUINO_RUNNING_CORE;
+#else
+const BaseType_t LOOP_CORE = 1;
+#endif
+const BaseType_t PLAYBACK_CORE = LOOP_CORE ^ 1;
+const uint32_t PLAYBACK_TASK_STACK = 4096;
+const UBaseType_t PLAYBACK_TASK_PRIORITY = 2;  // Above loop()
+const int PLAYBACK_EVENT_DEPTH = 8;
+const unsigned long CPU_REPORT_INTERVAL_MS = 10000;
+
+// loop() sleeps until the BLE controller sends HCI traffic or the playback task has
+// an event for it; these are only the fallback timeouts. While a message plays it
+// wakes every MORSE_PROGRESS_WAIT_MS to sample progress. 0 brings back the old busy
+// loop, for comparing the power report.
+#ifndef MORSE_LOOP_WAIT_MS
+#define MORSE_LOOP_WAIT_MS 100
+#endif
+#ifndef MORSE_PROGRESS_WAIT_MS
+#define MORSE_PROGRESS_WAIT_MS 5
+#endif
+
+// Supply current model for the power report, not a measurement: datasheet-order
+// figures for the ESP32-S3 at 240 MHz in modem sleep, not calibrated on this board,
+// and radio bursts are left out. Only compare reports from the same build.
+const float IDLE_CURRENT_MA = 32.0f;        // Both cores waiting for interrupts
+const float CORE_ACTIVE_CURRENT_MA = 25.0f; // Added per fully busy core
+
+// Timing characteristic value. Writes set the speed from the first two bytes (a
+// single byte sets wpm with standard spacing); reads and notifications also carry
+// the effective duration of the last message played.
+struct __attribute__((packed)) TimingValue {
+    uint8_t wpm;
+    uint8_t farnsworthWpm;
+    uint32_t lastMessageMs;
+};
+
+// Progress characteristic value: the letter being played. Notified at each letter,
+// and within a letter no more than every PROGRESS_MIN_INTERVAL_MS.
+struct __attribute__((packed)) ProgressValue {
+    uint8_t playing;
+    uint8_t message;     // Queued messages finished since playback started
+    uint16_t character;  // Byte offset of the letter's UTF-8 character in the message text
+    uint8_t symbol;      // Element within the letter
+};
+
+// Completion events sent from the playback task back to loop()
+enum PlaybackEvent : uint8_t {
+    PLAYBACK_STARTED,
+    PLAYBACK_FINISHED
+};
+
+// Busy time of a task; busyUs only grows (and wraps), the reporter keeps its own mark
+struct TaskCpuTime {
+    const char* name;
+    volatile int core;
+    volatile uint32_t busyUs;
+    uint32_t reportedUs;
+};
+
+// Per-core idle time, sampled from the tick interrupt: a tick that lands in the
+// idle task counts as idle
+struct CoreIdleTime {
+    volatile uint32_t ticks;
+    volatile uint32_t idleTicks;
+    uint32_t reportedTicks;
+    uint32_t reportedIdleTicks;
 };
 
 // Advertising state
 bool isConnected = false;
-unsigned long lastBlink = 0;
-bool blinkState = false;
+bool advertisingIndicated = false;
 
 // BLE Service and Characteristics
 BLEService morseService(MORSE_SERVICE_UUID);
-BLECharacteristic textInputChar(TEXT_INPUT_UUID, BLEWrite, 100);
+BLECharacteristic textInputChar(TEXT_INPUT_UUID, BLEWrite, TEXT_INPUT_MAX);
 BLECharacteristic morseOutputChar(MORSE_OUTPUT_UUID, BLERead | BLENotify, 400);
 BLECharacteristic hapticControlChar(HAPTIC_CONTROL_UUID, BLEWrite, sizeof(int));
 BLECharacteristic deviceStatusChar(DEVICE_STATUS_UUID, BLERead | BLENotify, sizeof(int));
+BLECharacteristic timingControlChar(TIMING_CONTROL_UUID, BLERead | BLEWrite | BLENotify, sizeof(TimingValue));
+BLECharacteristic transferDataChar(TRANSFER_DATA_UUID, BLEWrite | BLEWriteWithoutResponse, TRANSFER_HEADER_SIZE + TRANSFER_MAX_CHUNK);
+BLECharacteristic transferAckChar(TRANSFER_ACK_UUID, BLERead | BLENotify, TRANSFER_ACK_SIZE);
+BLECharacteristic echoFormatChar(ECHO_FORMAT_UUID, BLERead | BLEWrite, 3);  // [format][chunk size u16]
+BLECharacteristic progressChar(PLAYBACK_PROGRESS_UUID, BLERead | BLENotify, sizeof(ProgressValue));
+BLECharacteristic alphabetChar(ALPHABET_UUID, BLERead | BLEWrite, 1);  // MorseAlphabet for non-ASCII text
+BLECharacteristic presetChar(PRESETS_UUID, BLERead | BLEWrite | BLENotify, PRESET_VALUE_MAX);  // See preset_store.h
+
+// Reassembly of framed messages written to transferDataChar
+TransferReceiver transferReceiver;
+
+// Canned messages, compiled when stored and played straight from RAM; the flash
+// copy only brings them back after a restart
+PresetStore presets;
+Preferences presetFlash;
+bool presetFlashReady = false;
 
 // Morse code converter - start with LED only mode
 MorseConverter morse(VIBRATION_PIN, OutputMode::BOTH);
+
+// Echo and queueing of every message written; the echo goes out on morseOutputChar
+bool notifyEchoChunk(const uint8_t* data, size_t length, void* context);
+void reportStatus(DeviceStatus status, void* context);
+MessageIngest ingest(morse, notifyEchoChunk, nullptr, reportStatus, nullptr);
+
+#ifdef MORSE_RAM_BUDGET
+// The message pools alone; scripts/memory_budget.py checks all static RAM after linking
+static_assert(sizeof(morse) + sizeof(transferReceiver) + sizeof(ingest) + sizeof(presets) <= MORSE_RAM_BUDGET,
+              "Message buffers exceed MORSE_RAM_BUDGET");
+#endif
 DeviceStatus currentStatus = IDLE;
 int hapticIntensity = DEFAULT_HAPTIC_INTENSITY;
+uint32_t lastMessageMs = 0;  // Effective duration of the last message, for the timing characteristic
+ProgressThrottle progressThrottle;
+
+// Playback task and its handoffs: text goes in through the converter's lock-free
+// message queue, completion events come back through playbackEvents
+TaskHandle_t playbackTaskHandle = nullptr;
+QueueHandle_t playbackEvents = nullptr;
+TaskCpuTime playbackCpu = {"playback", -1, 0, 0};
+TaskCpuTime bleCpu = {"ble", -1, 0, 0};
+unsigned long lastCpuReport = 0;
+TaskHandle_t loopTaskHandle = nullptr;
+CoreIdleTime coreIdle[portNUM_PROCESSORS] = {};
+
+// Ends loop()'s wait for HCI traffic when the playback task has news for it
+void wakeLoopTask() {
+    if (loopTaskHandle) {
+        xTaskNotifyGive(loopTaskHandle);
+    }
+}
+
+// Receive side of ArduinoBLE's ESP32 transport (utility/HCIVirtualTransport.cpp):
+// the controller's VHCI callback writes every HCI packet here and BLE.poll() reads it.
+// Not public API, which is why platformio.ini pins the library version. The public
+// alternatives do not sleep: BLE events are dispatched from BLE.poll() on this task,
+// and BLE.poll(timeout) spins on the buffer.
+extern StreamBufferHandle_t rec_buffer;
+
+// Set while loop() has playback outstanding whose PLAYBACK_FINISHED it has not handled
+bool playbackPending = false;
+
+void waitForEvents() {
+#if MORSE_LOOP_WAIT_MS > 0
+    const TickType_t timeout = pdMS_TO_TICKS(playbackPending ? MORSE_PROGRESS_WAIT_MS : MORSE_LOOP_WAIT_MS);
+    if (!rec_buffer) {
+        ulTaskNotifyTake(pdTRUE, timeout);  // BLE never started
+        return;
+    }
+    if (xStreamBufferBytesAvailable(rec_buffer) > 0 || uxQueueMessagesWaiting(playbackEvents) > 0) {
+        return;
+    }
+    // A zero-byte receive blocks until a packet arrives and leaves it for BLE.poll().
+    // It waits on this task's notification, so wakeLoopTask() ends it as well. A wake
+    // given just before the receive starts waiting is dropped, but playback events
+    // only come while playbackPending holds the timeout at MORSE_PROGRESS_WAIT_MS,
+    // so one is never handled later than with the old fixed-interval poll.
+    uint8_t none;
+    xStreamBufferReceive(rec_buffer, &none, 0, timeout);
+#endif
+}
+
+// Playback task sleeps until there is playback or a status pattern to service
+void wakePlaybackTask() {
+    if (playbackTaskHandle) {
+        xTaskNotifyGive(playbackTaskHandle);
+    }
+}
+
+#ifdef MORSE_PLAYBACK_TIMER
+// From the playback ISR when its timeline runs low or ends; the task refills or
+// finishes it. IRAM, as the ISR also runs while flash is written.
+void IRAM_ATTR wakePlaybackTaskFromIsr(void* context) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(playbackTaskHandle, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+#endif
 
 void updateStatus(DeviceStatus status) {
     currentStatus = status;
+    if (status == PLAYING) {
+        playbackPending = true;
+    }
     int statusValue = static_cast<int>(status);
     deviceStatusChar.writeValue(&statusValue, sizeof(statusValue));
     
@@ -55,14 +232,201 @@ void updateStatus(DeviceStatus status) {
             morse.indicatePlaying();
             break;
         case ERROR:
+        case QUEUE_FULL:
             morse.indicateError();
             break;
     }
+    wakePlaybackTask();
+}
+
+bool notifyEchoChunk(const uint8_t* data, size_t length, void* context) {
+    return morseOutputChar.writeValue(data, length);
+}
+
+void reportStatus(DeviceStatus status, void* context) {
+    updateStatus(status);
+}
+
+// Applies the echo format and shows the app what was taken
+void setEchoFormat(EchoFormat format, bool streamed = false, size_t chunkSize = ECHO_DEFAULT_CHUNK,
+                   bool cacheAware = false) {
+    ingest.setEchoFormat(format, streamed, chunkSize, cacheAware);
+    const uint8_t value[3] = {
+        static_cast<uint8_t>(static_cast<uint8_t>(format) | (streamed ? ECHO_STREAMED : 0)
+                             | (cacheAware ? ECHO_CACHE_AWARE : 0)),
+        static_cast<uint8_t>(ingest.echoChunkSize() & 0xFF),
+        static_cast<uint8_t>(ingest.echoChunkSize() >> 8),
+    };
+    echoFormatChar.writeValue(value, sizeof(value));
+}
+
+// [format | ECHO_STREAMED | ECHO_CACHE_AWARE] and, for streaming, the chunk size (ATT MTU - 3)
+void handleEchoFormat(BLEDevice central, BLECharacteristic characteristic) {
+    const byte* data = characteristic.value();
+    const int dataLength = characteristic.valueLength();
+    const uint8_t format = data && dataLength >= 1 ? data[0] & ~(ECHO_STREAMED | ECHO_CACHE_AWARE) : 0xFF;
+    if (format > static_cast<uint8_t>(EchoFormat::DIGEST)) {
+        // Unknown format: keep the current one
+        setEchoFormat(ingest.echoFormat(), ingest.isEchoStreamed(), ingest.echoChunkSize(), ingest.isCacheAware());
+        return;
+    }
+    const size_t chunkSize = dataLength >= 3 ? data[1] | data[2] << 8 : ECHO_DEFAULT_CHUNK;
+    setEchoFormat(static_cast<EchoFormat>(format), data[0] & ECHO_STREAMED, chunkSize, data[0] & ECHO_CACHE_AWARE);
+    Serial.print(F("Echo format: "));
+    Serial.print(format);
+    Serial.print(ingest.isEchoStreamed() ? F(", streamed in ") : F(", single notification"));
+    if (ingest.isEchoStreamed()) {
+        Serial.print(ingest.echoChunkSize());
+        Serial.print(F("-byte chunks"));
+    }
+    if (ingest.isCacheAware()) {
+        Serial.print(F(", repeats as digests"));
+    }
+    Serial.println();
+}
+
+// Selects the alphabet for messages written from now on; unknown values keep the current one
+void handleAlphabet(BLEDevice central, BLECharacteristic characteristic) {
+    const byte* data = characteristic.value();
+    if (data && characteristic.valueLength() >= 1 && data[0] < MORSE_ALPHABET_COUNT) {
+        morse.setAlphabet(static_cast<MorseAlphabet>(data[0]));
+    }
+    const uint8_t alphabet = static_cast<uint8_t>(morse.getAlphabet());
+    alphabetChar.writeValue(&alphabet, sizeof(alphabet));
+    Serial.print(F("Alphabet: "));
+    Serial.println(alphabet);
+}
+
+// Echoes a complete message and queues it for playback. Returns PLAYING when it was
+// queued, otherwise the error status that was reported.
+DeviceStatus acceptMessage(const uint8_t* data, size_t messageLength, bool transfer = false) {
+    const DeviceStatus status = ingest.accept(data, messageLength, transfer);
+    if (status != PLAYING) {
+        return status;
+    }
+    const EchoCache& echoCache = ingest.echoCache();
+    Serial.print(F("Queued messages: "));
+    Serial.print(morse.queuedMessages());
+    Serial.print(F(", encoded ETA: "));
+    Serial.print(morse.getRemainingMs());
+    Serial.println(F(" ms"));
+    Serial.printf("Echo cache: %lu hits, %lu misses, %lu evictions, %u/%u stored\n", (unsigned long)echoCache.hits(),
+                  (unsigned long)echoCache.misses(), (unsigned long)echoCache.evictions(), (unsigned)echoCache.size(),
+                  (unsigned)EchoCache::SIZE);
+    return PLAYING;
+}
+
+// NVS key of a preset slot
+void presetKey(size_t slot, char* key, size_t size) {
+    snprintf(key, size, "slot%u", static_cast<unsigned>(slot));
+}
+
+// Brings back the presets saved by earlier runs; malformed blobs are erased
+void loadPresets() {
+    presetFlashReady = presetFlash.begin(PRESET_NAMESPACE, false);
+    if (!presetFlashReady) {
+        Serial.println(F("Preset storage unavailable; presets last until restart"));
+        return;
+    }
+
+    uint8_t image[PresetStore::MAX_IMAGE_SIZE];
+    for (size_t slot = 0; slot < PresetStore::CAPACITY; slot++) {
+        char key[12];
+        presetKey(slot, key, sizeof(key));
+        if (!presetFlash.isKey(key)) {
+            continue;
+        }
+        const size_t length = presetFlash.getBytes(key, image, sizeof(image));
+        if (!presets.loadSlot(slot, image, length)) {
+            presetFlash.remove(key);
+        }
+    }
+    Serial.printf("Presets: %u of %u slots in use\n", (unsigned)presets.size(), (unsigned)PresetStore::CAPACITY);
+}
+
+// Writes a slot to flash after it changed, or erases it once free
+bool savePresetSlot(size_t slot) {
+    if (!presetFlashReady) {
+        return false;
+    }
+    char key[12];
+    presetKey(slot, key, sizeof(key));
+    uint8_t image[PresetStore::MAX_IMAGE_SIZE];
+    const size_t length = presets.saveSlot(slot, image, sizeof(image));
+    return length ? presetFlash.putBytes(key, image, length) == length : presetFlash.remove(key);
+}
+
+// Queues a preset's symbols as they are: nothing to encode, and the app already has its echo
+PresetStatus playPreset(uint16_t id) {
+    const MorsePreset* preset = presets.find(id);
+    if (!preset) {
+        return PresetStatus::NOT_FOUND;
+    }
+    if (!morse.queuePacked(preset->packed, preset->symbolCount)) {
+        updateStatus(QUEUE_FULL);
+        return PresetStatus::QUEUE_FULL;
+    }
+    wakePlaybackTask();
+    updateStatus(PLAYING);
+    return PresetStatus::OK;
+}
+
+// STORE, DELETE, PLAY or LIST; the result is left in presetChar
+void handlePreset(BLEDevice central, BLECharacteristic characteristic) {
+    const byte* data = characteristic.value();
+    const int dataLength = characteristic.valueLength();
+    if (!data || dataLength < 1) {
+        return;
+    }
+
+    const uint8_t op = data[0];
+    if (op == PRESET_LIST) {
+        uint8_t value[PresetStore::MAX_LIST_SIZE];
+        presetChar.writeValue(value, presets.list(value, sizeof(value)));
+        return;
+    }
+
+    // PLAY takes a one-byte id as well, for the shortest possible write
+    const int minLength = op == PRESET_PLAY ? 2 : 3;
+    const uint16_t id = dataLength == 2 ? data[1] : (dataLength >= 3 ? data[1] | data[2] << 8 : 0);
+    PresetStatus status = PresetStatus::INVALID;
+    size_t slot = 0;
+    if (dataLength >= minLength && (op == PRESET_STORE || op == PRESET_DELETE) && morse.isPlaybackActive()) {
+        status = PresetStatus::BUSY;  // The flash write would stall playback
+    } else if (dataLength >= minLength) {
+        switch (op) {
+            case PRESET_PLAY:
+                status = playPreset(id);
+                break;
+            case PRESET_STORE: {
+                const PackedMorse& packed = morse.textToPackedMorse(reinterpret_cast<const char*>(data + 3), dataLength - 3);
+                status = morse.wasTruncated() ? PresetStatus::TOO_LARGE : presets.store(id, packed, slot);
+                if (status == PresetStatus::OK && !savePresetSlot(slot)) {
+                    status = PresetStatus::STORAGE_ERROR;
+                }
+                break;
+            }
+            case PRESET_DELETE:
+                status = presets.remove(id, slot);
+                if (status == PresetStatus::OK && !savePresetSlot(slot)) {
+                    status = PresetStatus::STORAGE_ERROR;
+                }
+                break;
+        }
+    }
+
+    const uint8_t value[PRESET_RESULT_SIZE] = {
+        op,
+        static_cast<uint8_t>(status),
+        static_cast<uint8_t>(id & 0xFF),
+        static_cast<uint8_t>(id >> 8),
+    };
+    presetChar.writeValue(value, sizeof(value));
+    Serial.printf("Preset op %u, id %u: status %u\n", op, id, static_cast<unsigned>(status));
 }
 
 void handleTextInput(BLEDevice central, BLECharacteristic characteristic) {
     // Get the text input
-    String text;
     const int dataLength = characteristic.valueLength();
     const byte* data = characteristic.value();
     
@@ -71,30 +435,41 @@ void handleTextInput(BLEDevice central, BLECharacteristic characteristic) {
         return;
     }
     
-    text.reserve(dataLength);
-    for (int i = 0; i < dataLength; i++) {
-        text += static_cast<char>(data[i]);
-    }
+    acceptMessage(data, min(dataLength, TEXT_INPUT_MAX));
+}
 
-    // Update status
-    updateStatus(PROCESSING);
+void handleTransferData(BLEDevice central, BLECharacteristic characteristic) {
+    const byte* frame = characteristic.value();
+    const int frameLength = characteristic.valueLength();
+    uint8_t value[TRANSFER_ACK_SIZE];
 
-    // Convert to Morse code
-    const char* morseCode = morse.textToMorse(text.c_str());
-    if (!morseCode || morseCode[0] == '\0') {
-        updateStatus(ERROR);
+    // A long message plays from the reassembly buffer; the next one waits until it is done
+    if (frame && frameLength >= (int)TRANSFER_HEADER_SIZE && frame[0] == TRANSFER_START
+        && morse.isQueued(transferReceiver.data())) {
+        const TransferAck busy = {frame[1], TransferStatus::BUSY, 0};
+        busy.encode(value);
+        transferAckChar.writeValue(value, sizeof(value));
         return;
     }
-    
-    // Send Morse code back through BLE
-    if (!morseOutputChar.writeValue(morseCode)) {
-        updateStatus(ERROR);
+
+    const bool wasComplete = transferReceiver.isComplete();
+    TransferAck ack;
+    if (!transferReceiver.receive(frame, frameLength, ack)) {
         return;
     }
 
-    // Start playback (non-blocking)
-    updateStatus(PLAYING);
-    morse.startPlayback(morseCode);
+    if (!wasComplete && transferReceiver.isComplete()) {
+        Serial.print(F("Transfer complete: "));
+        Serial.print(transferReceiver.length());
+        Serial.println(F(" bytes"));
+        if (acceptMessage(transferReceiver.data(), transferReceiver.length(), true) == QUEUE_FULL) {
+            transferReceiver.setCompletionStatus(TransferStatus::QUEUE_FULL);
+            ack.status = TransferStatus::QUEUE_FULL;
+        }
+    }
+
+    ack.encode(value);
+    transferAckChar.writeValue(value, sizeof(value));
 }
 
 void handleHapticControl(BLEDevice central, BLECharacteristic characteristic) {
@@ -116,25 +491,184 @@ void handleHapticControl(BLEDevice central, BLECharacteristic characteristic) {
     } else {
         morse.setPWM(0);
     }
+    wakePlaybackTask();
+}
+
+void publishTiming(const MorseTiming& timing) {
+    const TimingValue value = {timing.wpm, timing.farnsworthWpm, lastMessageMs};
+    timingControlChar.writeValue(&value, sizeof(value));
+}
+
+void handleTimingControl(BLEDevice central, BLECharacteristic characteristic) {
+    const byte* data = characteristic.value();
+    const int dataLength = characteristic.valueLength();
+    if (!data || dataLength < 1) {
+        return;
+    }
+
+    // Applied from the next edge on; a message in flight carries on at the new speed
+    const MorseTiming timing = morse.setTiming(data[0], dataLength > 1 ? data[1] : 0);
+    // Its sleep was sized from the remaining time at the old speed
+    wakePlaybackTask();
+    publishTiming(timing);
+    Serial.print(F("Timing: "));
+    Serial.print(timing.wpm);
+    Serial.print(F(" WPM, Farnsworth "));
+    Serial.print(timing.farnsworthWpm);
+    Serial.print(F(" WPM, dot "));
+    Serial.print(timing.dotUs / 1000);
+    Serial.println(F(" ms"));
+}
+
+// Runs the playback engine on PLAYBACK_CORE, away from BLE.poll()
+void playbackTask(void* parameter) {
+    playbackCpu.core = xPortGetCoreID();
+    Serial.print(F("Playback task ("));
+    Serial.print(MORSE_PLAYBACK_BACKEND);
+    Serial.print(F(" backend) running on core "));
+    Serial.println(playbackCpu.core);
+
+    // With the timer backend this binds the playback ISR to this core as well
+    morse.beginPlaybackEngine();
+
+    bool wasPlaying = false;
+    for (;;) {
+        const unsigned long start = micros();
+        morse.updatePlayback();
+        const bool playing = morse.isPlaybackActive();
+        if (playing != wasPlaying) {
+            const PlaybackEvent event = playing ? PLAYBACK_STARTED : PLAYBACK_FINISHED;
+            xQueueSend(playbackEvents, &event, 0);
+            wakeLoopTask();
+            wasPlaying = playing;
+        }
+        playbackCpu.busyUs += micros() - start;
+
+        // Sleep until text is queued or playback needs another look
+        TickType_t wait = portMAX_DELAY;
+        if (playing) {
+#ifdef MORSE_PLAYBACK_TIMER
+            wait = pdMS_TO_TICKS(morse.getRemainingMs()) + 1;  // Edges come from the ISR, which wakes us to refill
+#else
+            wait = 1;  // Poll edges once per tick
+#endif
+        } else if (morse.isStatusPatternActive()) {
+            wait = pdMS_TO_TICKS(morse.getStatusPatternWaitMs()) + 1;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+// Sampled from loop(); the playback task only stores the position, so notifying
+// never touches playback timing
+void publishProgress(unsigned long now) {
+    const PlaybackProgress progress = morse.getPlaybackProgress();
+    if (!progressThrottle.shouldSend(progress, now)) {
+        return;
+    }
+    const ProgressValue value = {progress.playing, progress.message, progress.character, progress.symbol};
+    progressChar.writeValue(&value, sizeof(value));
+}
+
+void reportCpuTime(TaskCpuTime& task, unsigned long windowMs) {
+    const uint32_t busyUs = task.busyUs;
+    const uint32_t deltaUs = busyUs - task.reportedUs;
+    task.reportedUs = busyUs;
+    Serial.printf("CPU: %s task on core %d busy %lu us in %lu ms (%.2f%%)\n", task.name, task.core,
+                  (unsigned long)deltaUs, windowMs, deltaUs / (windowMs * 10.0f));
+}
+
+void IRAM_ATTR sampleCoreIdle() {
+    const BaseType_t core = xPortGetCoreID();
+    coreIdle[core].ticks++;
+    if (xTaskGetCurrentTaskHandleForCPU(core) == xTaskGetIdleTaskHandleForCPU(core)) {
+        coreIdle[core].idleTicks++;
+    }
+}
+
+// Idle share of each core since the last report, and the supply current the model
+// above puts on it
+void reportPower() {
+    float currentMa = IDLE_CURRENT_MA;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        CoreIdleTime& idle = coreIdle[core];
+        const uint32_t ticks = idle.ticks - idle.reportedTicks;
+        const uint32_t idleTicks = idle.idleTicks - idle.reportedIdleTicks;
+        idle.reportedTicks += ticks;
+        idle.reportedIdleTicks += idleTicks;
+        const float idleShare = ticks ? static_cast<float>(idleTicks) / ticks : 1.0f;
+        currentMa += (1.0f - idleShare) * CORE_ACTIVE_CURRENT_MA;
+        Serial.printf("Power: core %d idle %.1f%%\n", core, idleShare * 100.0f);
+    }
+    Serial.printf("Power: modelled %.1f mA, radio excluded (loop fallback wait %d ms)\n", currentMa,
+                  MORSE_LOOP_WAIT_MS);
+}
+
+void reportCpuUsage() {
+    const unsigned long now = millis();
+    if (now - lastCpuReport < CPU_REPORT_INTERVAL_MS) {
+        return;
+    }
+    reportCpuTime(bleCpu, now - lastCpuReport);
+    reportCpuTime(playbackCpu, now - lastCpuReport);
+    reportPower();
+    lastCpuReport = now;
+}
+
+void handlePlaybackEvents() {
+    PlaybackEvent event;
+    while (xQueueReceive(playbackEvents, &event, 0) == pdTRUE) {
+        if (event != PLAYBACK_FINISHED) {
+            playbackPending = true;
+            continue;
+        }
+        playbackPending = morse.queuedMessages() > 0;  // Queued after this one finished
+        updateStatus(IDLE);
+
+        const MorseTiming timing = morse.getTiming();
+        lastMessageMs = morse.getMessageDurationMs();
+        publishTiming(timing);
+        Serial.printf("Message played in %lu ms (%u/%u WPM)\n", (unsigned long)lastMessageMs, timing.wpm, timing.farnsworthWpm);
+#ifdef MORSE_JITTER_PROBE
+        const PlaybackJitterStats& jitter = morse.getJitterStats();
+        Serial.printf("Playback jitter (%s): %u edges, mean late %lu us, max late %u us, max interval error %u us\n",
+                      MORSE_PLAYBACK_BACKEND, jitter.edges,
+                      jitter.edges ? (unsigned long)(jitter.totalLatenessUs / jitter.edges) : 0UL,
+                      jitter.maxLatenessUs, jitter.maxIntervalErrorUs);
+#endif
+    }
+}
+
+// BLEDevice::address() builds an Arduino String, so the static memory build leaves it out
+void printCentral(BLEDevice& central) {
+#ifdef MORSE_STATIC_MEMORY
+    (void)central;
+    Serial.print(F("(address not logged)"));
+#else
+    Serial.print(central.address());
+#endif
 }
 
 void blePeripheralConnectHandler(BLEDevice central) {
     isConnected = true;
     Serial.print(F("Connected to central: "));
-    Serial.print(central.address());
+    printCentral(central);
     Serial.print(F(" on core "));
     Serial.println(xPortGetCoreID());
     morse.indicateIdle();
+    setEchoFormat(EchoFormat::ASCII);  // Negotiated again on every connection
+    progressThrottle.reset();
     updateStatus(IDLE);
 }
 
 void blePeripheralDisconnectHandler(BLEDevice central) {
     isConnected = false;
     Serial.print(F("Disconnected from central: "));
-    Serial.print(central.address());
+    printCentral(central);
     Serial.print(F(" on core "));
     Serial.println(xPortGetCoreID());
     morse.clearStatus();
+    wakePlaybackTask();
 }
 
 void setup() {
@@ -148,6 +682,20 @@ void setup() {
     while (!Serial);
     #endif
 
+    // Start the playback task before BLE so write handlers can hand work to it
+    bleCpu.core = xPortGetCoreID();
+    loopTaskHandle = xTaskGetCurrentTaskHandle();
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        esp_register_freertos_tick_hook_for_cpu(sampleCoreIdle, core);
+    }
+    playbackEvents = xQueueCreate(PLAYBACK_EVENT_DEPTH, sizeof(PlaybackEvent));
+#ifdef MORSE_PLAYBACK_TIMER
+    morse.setPlaybackWakeHandler(wakePlaybackTaskFromIsr, nullptr);
+#endif
+    xTaskCreatePinnedToCore(playbackTask, "playback", PLAYBACK_TASK_STACK, nullptr,
+                            PLAYBACK_TASK_PRIORITY, &playbackTaskHandle, PLAYBACK_CORE);
+    loadPresets();
+
     // Initialize BLE
     if (!BLE.begin()) {
         Serial.println(F("Failed to initialize BLE!"));
@@ -164,16 +712,36 @@ void setup() {
     morseService.addCharacteristic(morseOutputChar);
     morseService.addCharacteristic(hapticControlChar);
     morseService.addCharacteristic(deviceStatusChar);
+    morseService.addCharacteristic(timingControlChar);
+    morseService.addCharacteristic(transferDataChar);
+    morseService.addCharacteristic(transferAckChar);
+    morseService.addCharacteristic(echoFormatChar);
+    morseService.addCharacteristic(progressChar);
+    morseService.addCharacteristic(alphabetChar);
+    morseService.addCharacteristic(presetChar);
 
     // Add service
     BLE.addService(morseService);
 
     // Set initial values
     updateStatus(IDLE);
+    publishTiming(morse.getTiming());
+    setEchoFormat(EchoFormat::ASCII);
+    const ProgressValue idleProgress = {};
+    progressChar.writeValue(&idleProgress, sizeof(idleProgress));
+    const uint8_t alphabet = static_cast<uint8_t>(morse.getAlphabet());
+    alphabetChar.writeValue(&alphabet, sizeof(alphabet));
+    uint8_t presetList[PresetStore::MAX_LIST_SIZE];
+    presetChar.writeValue(presetList, presets.list(presetList, sizeof(presetList)));
 
     // Set up event handlers
     textInputChar.setEventHandler(BLEWritten, handleTextInput);
     hapticControlChar.setEventHandler(BLEWritten, handleHapticControl);
+    timingControlChar.setEventHandler(BLEWritten, handleTimingControl);
+    transferDataChar.setEventHandler(BLEWritten, handleTransferData);
+    echoFormatChar.setEventHandler(BLEWritten, handleEchoFormat);
+    alphabetChar.setEventHandler(BLEWritten, handleAlphabet);
+    presetChar.setEventHandler(BLEWritten, handlePreset);
     BLE.setEventHandler(BLEConnected, blePeripheralConnectHandler);
     BLE.setEventHandler(BLEDisconnected, blePeripheralDisconnectHandler);
 
@@ -188,34 +756,43 @@ void loop() {
     BLEDevice central = BLE.central();
 
     if (central) {
+        advertisingIndicated = false;
+
         // Connection handling is now only in the callback handler
         while (central.connected()) {
-            // Update Morse code playback if active
-            morse.updatePlayback();
-            
-            // Check if playback just finished
-            static bool wasPlaying = false;
-            bool isPlaying = morse.isPlaybackActive();
-            if (wasPlaying && !isPlaying) {
-                updateStatus(IDLE);
-            }
-            wasPlaying = isPlaying;
-            
-            // Handle BLE events
+            // Handle BLE events; text writes are encoded for the echo and queued here
+            const unsigned long start = micros();
             BLE.poll();
+            bleCpu.busyUs += micros() - start;
+
+            handlePlaybackEvents();
+
+            publishProgress(millis());
+
+            // Clear back-pressure once a slot has been freed
+            if (currentStatus == QUEUE_FULL && !morse.isQueueFull()) {
+                updateStatus(morse.isPlaybackActive() ? PLAYING : IDLE);
+            }
+
+            reportCpuUsage();
+            waitForEvents();
         }
 
         // When disconnected
         isConnected = false;
         morse.clearStatus();
+        wakePlaybackTask();
     } else {
         // Blink LED while advertising
-        unsigned long now = millis();
-        if (now - lastBlink > 500) {  // Blink every 500ms
-            blinkState = !blinkState;
-            morse.setLED(blinkState);
-            lastBlink = now;
+        if (!advertisingIndicated) {
+            morse.indicateAdvertising();
+            wakePlaybackTask();
+            advertisingIndicated = true;
         }
+        const unsigned long start = micros();
         BLE.poll();
+        bleCpu.busyUs += micros() - start;
+        reportCpuUsage();
+        waitForEvents();
     }
 } 
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "message_ingest.h"
+#include <Arduino.h>
+#include <string.h>
+
+MessageIngest::MessageIngest(MorseConverter& morse, EchoChunkSink echoSink, void* echoContext,
+                             DeviceStatusSink statusSink, void* statusContext)
+    : morse(morse), echoSink(echoSink), echoContext(echoContext), statusSink(statusSink),
+      statusContext(statusContext) {
+}
+
+void MessageIngest::reportStatus(DeviceStatus status) {
+    if (statusSink) {
+        statusSink(status, statusContext);
+    }
+}
+
+DeviceStatus MessageIngest::accept(const uint8_t* data, size_t length, bool transfer) {
+    // Back-pressure: the message in flight and those queued behind it are left alone
+    if (morse.isQueueFull()) {
+        reportStatus(QUEUE_FULL);
+        return QUEUE_FULL;
+    }
+
+    reportStatus(PROCESSING);
+
+    // Send Morse code back through BLE
+    if (!sendEcho(data, length)) {
+        reportStatus(ERROR);
+        return ERROR;
+    }
+
+    // Hand over to the playback task; it follows the current message after a word gap
+    const bool queued = transfer ? morse.queueTransfer(data, length) : morse.queueText(data, length);
+    if (!queued) {
+        reportStatus(QUEUE_FULL);
+        return QUEUE_FULL;
+    }
+    reportStatus(PLAYING);
+    return PLAYING;
+}
+
+// Sends a whole echo as one notification
+bool MessageIngest::sendPackedEcho(const PackedMorse& packed, bool truncated) {
+    size_t length = 0;
+    switch (format) {
+        case EchoFormat::PACKED:
+            length = encodePackedEcho(packed, truncated, echoBuffer, sizeof(echoBuffer));
+            break;
+        case EchoFormat::DIGEST:
+            length = encodeDigestEcho(packed, truncated, echoBuffer, sizeof(echoBuffer));
+            break;
+        case EchoFormat::ASCII: {
+            const char* ascii = morse.packedToAscii(packed);
+            return echoSink(reinterpret_cast<const uint8_t*>(ascii), strlen(ascii), echoContext);
+        }
+    }
+    return length > 0 && echoSink(echoBuffer, length, echoContext);
+}
+
+// Encodes the echo, keeping its symbols in cached as they go by, and stores it in
+// the cache if it fits
+bool MessageIngest::sendEncodedEcho(const uint8_t* data, size_t length, CachedEcho& cached) {
+    if (streamed) {
+        // Encoded straight from the text into notification-sized chunks
+        MorseStreamEncoder encoder;
+        encoder.begin(reinterpret_cast<const char*>(data), length, cached.alphabet);
+        streamer.begin(format, chunkSize, echoSink, echoContext);
+        MorseSymbol symbol;
+        while (encoder.next(symbol)) {
+            streamer.add(symbol);
+            cached.add(symbol);
+        }
+        cached.sent = streamer.finish(false) && streamer.symbols() > 0;
+        cache.commit(cached, false);
+        return cached.sent;
+    }
+
+    // Convert to packed Morse code for the echo
+    const PackedMorse& packed = morse.textToPackedMorse(reinterpret_cast<const char*>(data), length);
+    if (packed.isEmpty()) {
+        return false;
+    }
+    const bool truncated = morse.wasTruncated();
+    if (truncated) {
+        Serial.println(F("Morse echo truncated to fit buffer"));
+    }
+    cached.assign(packed);
+    cached.sent = sendPackedEcho(packed, truncated);
+    cache.commit(cached, truncated);
+    return cached.sent;
+}
+
+// Replays a cached echo without encoding, or just its digest when this connection
+// already has it and understands that
+bool MessageIngest::sendCachedEcho(const CachedEcho& cached) {
+    if (cacheAware && cached.sent) {
+        const size_t length = encodeCachedEcho(streamed, cached.truncated, cached.symbolCount, cached.crc,
+                                               echoBuffer, sizeof(echoBuffer));
+        return length > 0 && echoSink(echoBuffer, length, echoContext);
+    }
+    if (streamed) {
+        streamer.begin(format, chunkSize, echoSink, echoContext);
+        for (size_t i = 0; i < cached.symbolCount; i++) {
+            streamer.add(cached.at(i));
+        }
+        return streamer.finish(cached.truncated);
+    }
+    return sendPackedEcho(morse.loadPackedMorse(cached.packed, cached.symbolCount, cached.truncated), cached.truncated);
+}
+
+bool MessageIngest::sendEcho(const uint8_t* data, size_t length) {
+    const MorseAlphabet alphabet = morse.getAlphabet();
+    const uint32_t hash = echoCacheHash(data, length, alphabet);
+    CachedEcho* cached = cache.find(hash, data, length, alphabet);
+    if (!cached) {
+        return sendEncodedEcho(data, length, cache.claim(hash, data, length, alphabet));
+    }
+    const bool sent = sendCachedEcho(*cached);
+    if (sent) {
+        cached->sent = true;
+    }
+    return sent;
+}
+
+void MessageIngest::setEchoFormat(EchoFormat format, bool streamed, size_t chunkSize, bool cacheAware) {
+    this->format = format;
+    this->streamed = streamed;
+    this->chunkSize = chunkSize < ECHO_MIN_CHUNK ? ECHO_MIN_CHUNK
+                      : chunkSize > ECHO_MAX_CHUNK ? ECHO_MAX_CHUNK
+                      : chunkSize;
+    this->cacheAware = cacheAware;
+    cache.forgetSent();  // Echoes sent before may have been in another format, or to another central
+}
+
+EchoFormat MessageIngest::echoFormat() const {
+    return format;
+}
+
+bool MessageIngest::isEchoStreamed() const {
+    return streamed;
+}
+
+size_t MessageIngest::echoChunkSize() const {
+    return chunkSize;
+}
+
+bool MessageIngest::isCacheAware() const {
+    return cacheAware;
+}
+
+const EchoCache& MessageIngest::echoCache() const {
+    return cache;
+}
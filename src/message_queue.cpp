@@ -0,0 +1,96 @@
+#include "message_queue.h"
+#include <string.h>
+
+bool MessageQueue::push(const uint8_t* data, size_t length, MorseAlphabet alphabet,
+                        const TimelineLength& timelineLength) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= DEPTH) {
+        return false;
+    }
+
+    QueuedMessage& slot = slots[t % DEPTH];
+    slot.length = length > MORSE_MESSAGE_MAX ? MORSE_MESSAGE_MAX : length;
+    slot.alphabet = alphabet;
+    slot.packed = false;
+    slot.timelineLength = timelineLength;
+    slot.source = slot.text;
+    memcpy(slot.text, data, slot.length);
+    slot.text[slot.length] = '\0';
+
+    // Publish the slot contents before the new tail
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool MessageQueue::pushPacked(const uint8_t* symbols, size_t symbolCount, const TimelineLength& timelineLength) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= DEPTH || symbolCount > MORSE_QUEUE_SYMBOLS) {
+        return false;
+    }
+
+    QueuedMessage& slot = slots[t % DEPTH];
+    slot.length = symbolCount;
+    slot.alphabet = MorseAlphabet::LATIN;
+    slot.packed = true;
+    slot.timelineLength = timelineLength;
+    slot.source = slot.text;
+    memcpy(slot.text, symbols, (symbolCount + 3) / 4);
+
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool MessageQueue::pushBorrowed(const uint8_t* data, size_t length, MorseAlphabet alphabet,
+                                const TimelineLength& timelineLength) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= DEPTH || length > UINT16_MAX) {
+        return false;
+    }
+
+    QueuedMessage& slot = slots[t % DEPTH];
+    slot.length = length;
+    slot.alphabet = alphabet;
+    slot.packed = false;
+    slot.timelineLength = timelineLength;
+    slot.source = reinterpret_cast<const char*>(data);
+
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool MessageQueue::holds(const void* data) const {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    for (uint32_t i = head.load(std::memory_order_acquire); i != t; i++) {
+        if (slots[i % DEPTH].source == data) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const QueuedMessage* MessageQueue::front() const {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    if (tail.load(std::memory_order_acquire) == h) {
+        return nullptr;
+    }
+    return &slots[h % DEPTH];
+}
+
+void MessageQueue::pop() {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    if (h != tail.load(std::memory_order_acquire)) {
+        head.store(h + 1, std::memory_order_release);
+    }
+}
+
+size_t MessageQueue::size() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+bool MessageQueue::isEmpty() const {
+    return size() == 0;
+}
+
+bool MessageQueue::isFull() const {
+    return size() >= DEPTH;
+}
@@ -0,0 +1,137 @@
+#include "message_transfer.h"
+#include <string.h>
+
+static uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | p[1] << 8);
+}
+
+void TransferAck::encode(uint8_t* out) const {
+    out[0] = transferId;
+    out[1] = static_cast<uint8_t>(status);
+    out[2] = nextSequence & 0xFF;
+    out[3] = nextSequence >> 8;
+}
+
+void TransferReceiver::reset() {
+    open = false;
+    totalLength = 0;
+    chunkCount = 0;
+    nextSequence = 0;
+    sinceAck = 0;
+    completion = TransferStatus::COMPLETE;
+}
+
+bool TransferReceiver::hasChunk(uint16_t sequence) const {
+    return receivedChunks[sequence / 8] & (1 << (sequence % 8));
+}
+
+bool TransferReceiver::receive(const uint8_t* frame, size_t length, TransferAck& ack) {
+    if (!frame || length < TRANSFER_HEADER_SIZE) {
+        return false;
+    }
+
+    const uint8_t type = frame[0];
+    const uint8_t id = frame[1];
+    const uint16_t sequence = readU16(frame + 2);
+    const uint8_t* payload = frame + TRANSFER_HEADER_SIZE;
+    const size_t payloadLength = length - TRANSFER_HEADER_SIZE;
+
+    ack.transferId = id;
+    ack.status = TransferStatus::IN_PROGRESS;
+
+    switch (type) {
+        case TRANSFER_START: {
+            // A new START replaces whatever was in progress
+            reset();
+            transferId = id;
+            ack.nextSequence = 0;
+            if (payloadLength < 5) {
+                ack.status = TransferStatus::TOO_LARGE;
+                return true;
+            }
+            totalLength = readU16(payload);
+            chunkSize = readU16(payload + 2);
+            if (totalLength == 0 || totalLength > MORSE_TRANSFER_MAX
+                || chunkSize < TRANSFER_MIN_CHUNK || chunkSize > TRANSFER_MAX_CHUNK) {
+                ack.status = TransferStatus::TOO_LARGE;
+                return true;
+            }
+            chunkCount = (totalLength + chunkSize - 1) / chunkSize;
+            ackEvery = payload[4] > 1 ? payload[4] / 2 : 1;
+            memset(receivedChunks, 0, (chunkCount + 7) / 8);
+            open = true;
+            return true;
+        }
+
+        case TRANSFER_DATA: {
+            if (id == transferId && isComplete()) {
+                // The completion ack was lost
+                ack.status = completion;
+                ack.nextSequence = nextSequence;
+                return true;
+            }
+            if (!open || id != transferId) {
+                ack.status = TransferStatus::NO_TRANSFER;
+                ack.nextSequence = 0;
+                return true;
+            }
+            ack.nextSequence = nextSequence;
+
+            const size_t offset = static_cast<size_t>(sequence) * chunkSize;
+            const size_t expected = sequence + 1 < chunkCount ? chunkSize : totalLength - offset;
+            if (sequence >= chunkCount || payloadLength != expected) {
+                return false;
+            }
+            if (hasChunk(sequence)) {
+                // Duplicate: the sender missed an ack, repeat it
+                return true;
+            }
+
+            // Out-of-order chunks are kept and the gap is reported right away
+            memcpy(buffer + offset, payload, payloadLength);
+            receivedChunks[sequence / 8] |= 1 << (sequence % 8);
+            if (sequence != nextSequence) {
+                return true;
+            }
+
+            while (nextSequence < chunkCount && hasChunk(nextSequence)) {
+                nextSequence++;
+                sinceAck++;
+            }
+            ack.nextSequence = nextSequence;
+            if (nextSequence == chunkCount) {
+                open = false;
+                ack.status = TransferStatus::COMPLETE;
+                return true;
+            }
+            if (sinceAck >= ackEvery) {
+                sinceAck = 0;
+                return true;
+            }
+            return false;
+        }
+
+        case TRANSFER_ABORT:
+            reset();
+            ack.status = TransferStatus::ABORTED;
+            ack.nextSequence = 0;
+            return true;
+    }
+    return false;
+}
+
+bool TransferReceiver::isComplete() const {
+    return !open && chunkCount > 0 && nextSequence == chunkCount;
+}
+
+void TransferReceiver::setCompletionStatus(TransferStatus status) {
+    completion = status;
+}
+
+const uint8_t* TransferReceiver::data() const {
+    return buffer;
+}
+
+size_t TransferReceiver::length() const {
+    return totalLength;
+}
@@ -1,14 +1,52 @@
 #include "morse_converter.h"
 
-const char* MorseConverter::findMorseCode(char c) {
-    char upperChar = toupper(c);
-    
-    for (int i = 0; i < MORSE_TABLE_SIZE; i++) {
-        if (MORSE_TABLE[i].character == upperChar) {
-            return MORSE_TABLE[i].code;
+#ifdef MORSE_PLAYBACK_TIMER
+#include <driver/timer.h>
+#include <hal/gpio_ll.h>
+#include <hal/ledc_ll.h>
+
+// Timer 0 of group 0 counting microseconds (80 MHz APB / 80)
+static const timer_group_t PLAYBACK_TIMER_GROUP = TIMER_GROUP_0;
+static const timer_idx_t PLAYBACK_TIMER_NUM = TIMER_0;
+static const uint32_t PLAYBACK_TIMER_DIVIDER = 80;
+static portMUX_TYPE playbackMux = portMUX_INITIALIZER_UNLOCKED;
+
+// The playback edge runs in the timer ISR, which stays enabled while flash is busy
+#define PLAYBACK_EDGE IRAM_ATTR
+#else
+#define PLAYBACK_EDGE
+#endif
+
+// Compiles symbols once without storing them, for the ETA
+static TimelineLength countPackedLength(const uint8_t* symbols, size_t from, size_t count) {
+    TimelineCompiler compiler;
+    TimelineEvent events[2];
+    TimelineLength length;
+    for (size_t i = from; i < count; i++) {
+        const uint8_t eventCount = compiler.compile(packedSymbolAt(symbols, i), events);
+        for (uint8_t j = 0; j < eventCount; j++) {
+            length.add(events[j]);
         }
     }
-    return "";
+    return length;
+}
+
+static TimelineLength countTextLength(MorseStreamEncoder scan) {
+    TimelineCompiler compiler;
+    TimelineEvent events[2];
+    TimelineLength length;
+    MorseSymbol symbol;
+    while (scan.next(symbol)) {
+        const uint8_t eventCount = compiler.compile(symbol, events);
+        for (uint8_t j = 0; j < eventCount; j++) {
+            length.add(events[j]);
+        }
+    }
+    return length;
+}
+
+const char* MorseConverter::findMorseCode(char c) {
+    return morseCodeFor(c);
 }
 
 void MorseConverter::setLED(bool state) {
@@ -30,13 +68,74 @@ void MorseConverter::updateOutputs(bool state, uint8_t intensity) {
     }
 }
 
+// Playback edge outputs. In the timer ISR the pins are written through the
+// register-level HAL, whose inline calls are safe while flash is busy.
+void PLAYBACK_EDGE MorseConverter::driveOutputs(bool level) {
+#ifdef MORSE_PLAYBACK_TIMER
+    if (outputMode != OutputMode::LED_ONLY) {
+        const ledc_channel_t channel = static_cast<ledc_channel_t>(pwmChannel);
+        ledc_ll_set_duty_int_part(LEDC_LL_GET_HW(), LEDC_LOW_SPEED_MODE, channel, level ? hapticIntensity : 0);
+        ledc_ll_set_duty_start(LEDC_LL_GET_HW(), LEDC_LOW_SPEED_MODE, channel, true);
+        ledc_ll_ls_channel_update(LEDC_LL_GET_HW(), LEDC_LOW_SPEED_MODE, channel);
+    }
+    if (outputMode != OutputMode::VIBRATION_ONLY) {
+        gpio_ll_set_level(&GPIO, static_cast<gpio_num_t>(LED_PIN), !level);  // Active LOW
+    }
+#else
+    updateOutputs(level, hapticIntensity);
+#endif
+}
+
 void MorseConverter::setPWM(uint8_t value) {
     hapticIntensity = value;
     
-    // Do a brief demo buzz at the new intensity (one dash length)
-    ledcWrite(pwmChannel, value);
-    delay(DASH_DURATION);
-    ledcWrite(pwmChannel, 0);
+    // Brief demo buzz at the new intensity (one dash length)
+    requestPattern(StatusPattern::HAPTIC_PREVIEW);
+}
+
+void MorseConverter::requestPattern(StatusPattern pattern) {
+    // The message is the status while it plays; a pattern kept until the queue drains
+    // would fire long after the event it reported
+    if (isPlaying) {
+        return;
+    }
+    requestedPattern.store(static_cast<uint8_t>(pattern), std::memory_order_release);
+}
+
+void MorseConverter::applyPatternStep(const PatternStep& step) {
+    if ((step.outputs & PATTERN_LED) && outputMode != OutputMode::VIBRATION_ONLY) {
+        setLED(step.level);
+    }
+    if (step.outputs & PATTERN_HAPTIC) {
+        ledcWrite(pwmChannel, step.level ? hapticIntensity : 0);
+    }
+}
+
+// Runs in the playback context while idle, so patterns never race Morse output
+void MorseConverter::updateStatusPattern() {
+    const unsigned long now = millis();
+    const StatusPattern requested = static_cast<StatusPattern>(
+        requestedPattern.exchange(static_cast<uint8_t>(StatusPattern::NONE), std::memory_order_acquire));
+    if (requested != StatusPattern::NONE) {
+        statusSequencer.start(requested, now);
+    }
+
+    PatternStep step;
+    while (statusSequencer.update(now, step)) {
+        applyPatternStep(step);
+    }
+}
+
+bool MorseConverter::isStatusPatternActive() const {
+    return statusSequencer.isActive()
+           || requestedPattern.load(std::memory_order_relaxed) != static_cast<uint8_t>(StatusPattern::NONE);
+}
+
+uint32_t MorseConverter::getStatusPatternWaitMs() const {
+    if (requestedPattern.load(std::memory_order_relaxed) != static_cast<uint8_t>(StatusPattern::NONE)) {
+        return 0;
+    }
+    return statusSequencer.msUntilNextStep(millis());
 }
 
 MorseConverter::MorseConverter(uint8_t vib_pin, OutputMode mode) 
@@ -47,14 +146,9 @@ MorseConverter::MorseConverter(uint8_t vib_pin, OutputMode mode)
     
     // Set up PWM for vibration
     setupPWM();
-    
-    // Startup sequence - three quick blinks
-    for (int i = 0; i < 3; i++) {
-        setLED(true);
-        delay(100);
-        setLED(false);
-        delay(100);
-    }
+
+    // Startup sequence - three quick blinks, played once playback is serviced
+    requestPattern(StatusPattern::STARTUP);
 
     if (false) {  // Toggle this to false to disable PWM test
         // Test all pins with PWM
@@ -102,78 +196,581 @@ OutputMode MorseConverter::getOutputMode() const {
     return outputMode;
 }
 
+void MorseConverter::setAlphabet(MorseAlphabet alphabet) {
+    this->alphabet = alphabet;
+}
+
+MorseAlphabet MorseConverter::getAlphabet() const {
+    return alphabet;
+}
+
+size_t MorseConverter::encodedLength(const char* text) const {
+    return morseEncodedLength(text, alphabet);
+}
+
 const char* MorseConverter::textToMorse(const char* text) {
-    morseBuffer[0] = '\0';
-    
-    for (int i = 0; text[i] != '\0'; i++) {
-        if (i > 0) {
-            strcat(morseBuffer, " ");
+    truncated = encodeMorse(text, morseBuffer, sizeof(morseBuffer), alphabet).truncated;
+    return morseBuffer;
+}
+
+bool MorseConverter::wasTruncated() const {
+    return truncated;
+}
+
+const PackedMorse& MorseConverter::textToPackedMorse(const char* text) {
+    return textToPackedMorse(text, text ? strlen(text) : 0);
+}
+
+const PackedMorse& MorseConverter::textToPackedMorse(const char* text, size_t length) {
+    packedBuffer.clear();
+    truncated = false;
+
+    MorseStreamEncoder encoder;
+    encoder.begin(text, length, alphabet);
+
+    MorseSymbol symbol;
+    size_t letterEnd = 0;
+    while (encoder.next(symbol)) {
+        if (symbol >= MorseSymbol::LETTER_GAP) {
+            letterEnd = packedBuffer.length();
+        }
+        if (!packedBuffer.append(symbol)) {
+            // Never end on a partial letter
+            packedBuffer.truncate(letterEnd);
+            truncated = true;
+            break;
         }
-        const char* morseChar = findMorseCode(text[i]);
-        strcat(morseBuffer, morseChar);
     }
-    
+
+    return packedBuffer;
+}
+
+const PackedMorse& MorseConverter::loadPackedMorse(const uint8_t* bytes, size_t symbolCount, bool truncated) {
+    if (!packedBuffer.assign(bytes, symbolCount)) {
+        packedBuffer.clear();
+    }
+    this->truncated = truncated;
+    return packedBuffer;
+}
+
+const char* MorseConverter::packedToAscii(const PackedMorse& morse) {
+    morse.toAscii(morseBuffer, sizeof(morseBuffer));
     return morseBuffer;
 }
 
 void MorseConverter::startPlayback(const char* morse) {
-    currentMorse = morse;
-    currentPosition = 0;
+    if (!morse) {
+        stopPlayback();
+        return;
+    }
+    packedBuffer.fromAscii(morse);
+    startPlayback(packedBuffer);
+}
+
+void MorseConverter::startPlayback(const PackedMorse& morse) {
+    stopPlayback();
+    packedSymbols = morse.bytes();
+    packedLength = morse.length();
+    beginPlayback();
+}
+
+void MorseConverter::startTextPlayback(const char* text, size_t length) {
+    stopPlayback();
+    textEncoder.begin(text, length, alphabet);
+    beginPlayback();
+}
+
+void MorseConverter::setPlaybackWakeHandler(void (*handler)(void* context), void* context) {
+    wakeHandler = handler;
+    wakeContext = context;
+}
+
+void MorseConverter::beginPlaybackEngine() {
+#ifdef MORSE_PLAYBACK_TIMER
+    // Timer interrupts are serviced on the core that registered them. The IDF driver is
+    // used rather than timerBegin() so the interrupt can be IRAM-resident.
+    if (!timerReady) {
+        timer_config_t config = {};
+        config.divider = PLAYBACK_TIMER_DIVIDER;
+        config.counter_dir = TIMER_COUNT_UP;
+        config.counter_en = TIMER_PAUSE;
+        config.alarm_en = TIMER_ALARM_DIS;
+        config.auto_reload = TIMER_AUTORELOAD_DIS;
+        timer_init(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, &config);
+        timer_set_counter_value(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, 0);
+        timer_isr_callback_add(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, &MorseConverter::onPlaybackTimer, this,
+                               ESP_INTR_FLAG_IRAM);
+        timer_start(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM);
+        timerReady = true;
+    }
+#endif
+}
+
+// The message is scanned here, on the producer's task, so chaining it onto playback
+// only adds up stored lengths
+bool MorseConverter::queueText(const uint8_t* data, size_t length) {
+    if (messageQueue.isFull()) {
+        return false;
+    }
+    const size_t kept = length > MessageQueue::MAX_LENGTH ? MessageQueue::MAX_LENGTH : length;
+    MorseStreamEncoder scan;
+    scan.begin(reinterpret_cast<const char*>(data), kept, alphabet);
+    return messageQueue.push(data, kept, alphabet, countTextLength(scan));
+}
+
+bool MorseConverter::queueTransfer(const uint8_t* data, size_t length) {
+    if (length <= MessageQueue::MAX_LENGTH) {
+        return queueText(data, length);
+    }
+    if (messageQueue.isFull()) {
+        return false;
+    }
+    MorseStreamEncoder scan;
+    scan.begin(reinterpret_cast<const char*>(data), length, alphabet);
+    return messageQueue.pushBorrowed(data, length, alphabet, countTextLength(scan));
+}
+
+bool MorseConverter::isQueued(const uint8_t* data) const {
+    return messageQueue.holds(data);
+}
+
+bool MorseConverter::queuePacked(const uint8_t* symbols, size_t symbolCount) {
+    if (messageQueue.isFull()) {
+        return false;
+    }
+    return messageQueue.pushPacked(symbols, symbolCount, countPackedLength(symbols, 0, symbolCount));
+}
+
+size_t MorseConverter::queuedMessages() const {
+    return messageQueue.size();
+}
+
+bool MorseConverter::isQueueFull() const {
+    return messageQueue.isFull();
+}
+
+void MorseConverter::beginPlayback() {
+    beginPlaybackEngine();
+
+    // The message itself is the status from here on; drop patterns asked for before it
+    requestedPattern.store(static_cast<uint8_t>(StatusPattern::NONE), std::memory_order_relaxed);
+    if (statusSequencer.isActive()) {
+        statusSequencer.cancel();
+        applyPatternStep({PATTERN_LED | PATTERN_HAPTIC, false, 0});
+    }
+    postRequestedTiming();
+    timeline.clear();
+    messageLength = countMessageLength();
+    playedLength = TimelineLength();
+    currentEvent = 0;
+    currentEventUs = 0;
+    playedUs = 0;
+    letterPending = true;
+    messageIndex = 0;
+    packedLetters = 0;
+    compiledProgress = {};
+    playbackOpen = true;
+    sourceDone = false;
+    starved = false;
+    refillTimeline();
+    if (timeline.isEmpty()) {
+        stopPlayback();
+        return;
+    }
+
     isPlaying = true;
-    playbackState = PlaybackState::SYMBOL_ON;
-    lastStateChange = millis();
-    
-    // Calculate initial duration based on first symbol
-    if (morse && morse[0] != '\0') {
-        currentDuration = (morse[0] == '.') ? DOT_DURATION : DASH_DURATION;
-        updateOutputs(true, hapticIntensity);
+#ifdef MORSE_JITTER_PROBE
+    jitterStats = {};
+    idealEdgeUs = micros();
+    lastLatenessUs = 0;
+#endif
+
+#ifdef MORSE_PLAYBACK_TIMER
+    portENTER_CRITICAL(&playbackMux);
+    timer_set_counter_value(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, 0);
+    nextDeadlineUs = 0;
+    advancePlayback();
+    timer_set_alarm_value(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, nextDeadlineUs);
+    timer_set_alarm(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, TIMER_ALARM_EN);
+    portEXIT_CRITICAL(&playbackMux);
+#else
+    nextDeadlineUs = micros();
+    advancePlayback();
+#endif
+}
+
+bool MorseConverter::nextSymbol(MorseSymbol& symbol) {
+    if (packedSymbols) {
+        if (currentPosition >= (int)packedLength) {
+            return false;
+        }
+        symbol = packedSymbolAt(packedSymbols, currentPosition);
+    } else if (!textEncoder.next(symbol)) {
+        return false;
     }
+    currentPosition++;
+    return true;
 }
 
-void MorseConverter::updatePlayback() {
-    if (!isPlaying || !currentMorse) return;
-    
-    unsigned long now = millis();
-    if (now - lastStateChange < currentDuration) return;
-    
-    switch (playbackState) {
-        case PlaybackState::SYMBOL_ON:
-            updateOutputs(false, hapticIntensity);
-            playbackState = PlaybackState::SYMBOL_OFF;
-            currentDuration = SYMBOL_SPACE;
-            break;
-            
-        case PlaybackState::SYMBOL_OFF:
-        case PlaybackState::LETTER_SPACE:
-            currentPosition++;
-            if (currentMorse[currentPosition] == '\0') {
-                stopPlayback();
-                return;
-            }
-            
-            if (currentMorse[currentPosition] == ' ') {
-                playbackState = PlaybackState::LETTER_SPACE;
-                currentDuration = LETTER_SPACE;
-            } else {
-                playbackState = PlaybackState::SYMBOL_ON;
-                currentDuration = (currentMorse[currentPosition] == '.') ? DOT_DURATION : DASH_DURATION;
-                updateOutputs(true, hapticIntensity);
+// Compiles one symbol, with the progress its mark publishes once it is heard
+void MorseConverter::compileSymbol(MorseSymbol symbol) {
+    if (symbol != MorseSymbol::DOT && symbol != MorseSymbol::DASH) {
+        letterPending = true;
+    } else if (letterPending) {
+        const uint16_t character = packedSymbols ? packedLetters++ : textEncoder.letterPosition();
+        compiledProgress = {true, messageIndex, character, 0};
+        letterPending = false;
+    } else {
+        compiledProgress.symbol++;
+    }
+    timeline.push(symbol, compiledProgress.pack());
+}
+
+// Compiles the rest of the message being started once without storing it, for the ETA
+TimelineLength MorseConverter::countMessageLength() const {
+    if (packedSymbols) {
+        return countPackedLength(packedSymbols, currentPosition, packedLength);
+    }
+    return countTextLength(textEncoder);
+}
+
+MorseTiming MorseConverter::setTiming(uint8_t wpm, uint8_t farnsworthWpm) {
+    const MorseTiming next = makeMorseTiming(wpm, farnsworthWpm);
+    requestedTiming.store(static_cast<uint16_t>(next.wpm << 8 | next.farnsworthWpm), std::memory_order_release);
+    return next;
+}
+
+MorseTiming MorseConverter::getTiming() const {
+    const uint16_t requested = requestedTiming.load(std::memory_order_acquire);
+    return requested ? makeMorseTiming(requested >> 8, requested & 0xFF) : timingPending ? pendingTiming : timing;
+}
+
+// Playback task only: works out a posted speed. While playing, the edge takes it up
+// between events, so events already scheduled keep the speed they started with.
+void MorseConverter::postRequestedTiming() {
+    if (!requestedTiming.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const uint16_t requested = requestedTiming.exchange(0, std::memory_order_acquire);
+    const MorseTiming next = makeMorseTiming(requested >> 8, requested & 0xFF);
+#ifdef MORSE_PLAYBACK_TIMER
+    portENTER_CRITICAL(&playbackMux);
+#endif
+    if (isPlaying) {
+        pendingTiming = next;
+        timingPending = true;
+    } else {
+        timing = next;
+        timingPending = false;
+    }
+#ifdef MORSE_PLAYBACK_TIMER
+    portEXIT_CRITICAL(&playbackMux);
+#endif
+}
+
+// Playback task only: everything left to play is in the timeline. Set under the
+// lock, so the edge never sees it without the events pushed before it.
+void MorseConverter::closeSource() {
+    if (sourceDone) {
+        return;
+    }
+#ifdef MORSE_PLAYBACK_TIMER
+    portENTER_CRITICAL(&playbackMux);
+#endif
+    sourceDone = true;
+#ifdef MORSE_PLAYBACK_TIMER
+    portEXIT_CRITICAL(&playbackMux);
+#endif
+}
+
+// Playback task only: takes back closeSource() to chain a message queued late;
+// false when the edge has already played the last event
+bool MorseConverter::reopenSource() {
+    if (!sourceDone) {
+        return true;
+    }
+#ifdef MORSE_PLAYBACK_TIMER
+    portENTER_CRITICAL(&playbackMux);
+#endif
+    const bool reopened = isPlaying;
+    if (reopened) {
+        sourceDone = false;
+    }
+#ifdef MORSE_PLAYBACK_TIMER
+    portEXIT_CRITICAL(&playbackMux);
+#endif
+    return reopened;
+}
+
+// Releases the current queue slot and continues with the next queued message, one
+// word gap after the last. Messages with nothing to play are skipped. O(1): the
+// producer counted each message's length when it was queued.
+bool MorseConverter::chainQueuedMessage() {
+    if (!playingQueue) {
+        return false;
+    }
+
+    while (true) {
+        // The encoder is done with this slot; its events are copied into the timeline
+        if (queuedMessage) {
+            messageQueue.pop();
+            queuedMessage = nullptr;
+        }
+
+        // Left queued if playback ended meanwhile; updatePlayback() starts it afresh
+        const QueuedMessage* next = messageQueue.front();
+        if (!next || !reopenSource()) {
+            return false;
+        }
+
+        queuedMessage = next;
+        if (next->packed) {
+            // A preset: its symbols play as they are, with nothing to encode
+            textEncoder.reset();
+            packedSymbols = reinterpret_cast<const uint8_t*>(next->source);
+            packedLength = next->length;
+            currentPosition = 0;
+            packedLetters = 0;
+        } else {
+            packedSymbols = nullptr;
+            textEncoder.begin(next->source, next->length, next->alphabet);
+        }
+        if (!next->timelineLength.isEmpty()) {
+            if (!messageLength.isEmpty()) {
+                timeline.push(MorseSymbol::WORD_GAP, 0);
+                messageLength.wordGaps++;
+                letterPending = true;
+                messageIndex++;
             }
+            messageLength.add(next->timelineLength);
+            return true;
+        }
+    }
+}
+
+void MorseConverter::refillTimeline() {
+    MorseSymbol symbol;
+    while (timeline.hasRoom()) {
+        if (nextSymbol(symbol)) {
+            compileSymbol(symbol);
+        } else if (!chainQueuedMessage()) {
+            closeSource();
             break;
-            
-        default:
-            break;
+        }
     }
+}
+
+void MorseConverter::updatePlayback() {
+    if (!isPlaying && playbackOpen) {
+        finishPlayback();  // The edge has played the last event
+    }
+    if (!isPlaying) {
+        // Start the queue when idle; once running, the engine moves between messages itself
+        if (!messageQueue.isEmpty()) {
+            playingQueue = true;
+            beginPlayback();
+        } else {
+            updateStatusPattern();
+        }
+        return;
+    }
+
+    // Compile ahead of the edge, which only plays what is already in the timeline;
+    // in batches, once half of it has played, and again only if a message is queued
+    // after the source ran out
+    postRequestedTiming();
+    if (timeline.size() <= MorseTimeline::CAPACITY / 2 && (!sourceDone || !messageQueue.isEmpty())) {
+        refillTimeline();
+    }
+
+#ifdef MORSE_PLAYBACK_TIMER
+    resumeIfStarved();
+#else
+    
+    // Deadlines are absolute, so a late call shortens the next event instead of drifting
+    const unsigned long now = micros();
+    if (static_cast<long>(now - static_cast<unsigned long>(nextDeadlineUs)) < 0) return;
     
-    lastStateChange = now;
+    advancePlayback();
+    if (!isPlaying) {
+        finishPlayback();
+    }
+#endif
+}
+
+#ifdef MORSE_PLAYBACK_TIMER
+bool IRAM_ATTR MorseConverter::onPlaybackTimer(void* arg) {
+    MorseConverter* self = static_cast<MorseConverter*>(arg);
+    bool wake = false;
+    portENTER_CRITICAL_ISR(&playbackMux);
+    if (self->isPlaying && !self->starved) {
+        wake = self->advancePlayback();
+        // The driver re-arms the alarm only if it was moved here
+        if (self->isPlaying && !self->starved) {
+            timer_group_set_alarm_value_in_isr(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, self->nextDeadlineUs);
+        }
+    }
+    portEXIT_CRITICAL_ISR(&playbackMux);
+
+    // The timeline is running low or has drained: have the playback task refill or finish it
+    if (wake && self->wakeHandler) {
+        self->wakeHandler(self->wakeContext);
+    }
+    return false;
+}
+
+// The edge ran out of events before the task refilled them (the task was held up
+// for over half a timeline); playback carries on from now, one edge late
+void MorseConverter::resumeIfStarved() {
+    portENTER_CRITICAL(&playbackMux);
+    if (starved) {
+        starved = false;
+        timer_get_counter_value(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, &nextDeadlineUs);
+        advancePlayback();
+        if (isPlaying && !starved) {
+            timer_set_alarm_value(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, nextDeadlineUs);
+            timer_set_alarm(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, TIMER_ALARM_EN);
+        }
+    }
+    portEXIT_CRITICAL(&playbackMux);
+}
+#endif
+
+// The playback edge: starts the next compiled event at nextDeadlineUs. With the timer
+// backend it runs in the ISR from IRAM, so it only pops and plays; compiling is left to
+// the playback task. Returns true when the task is needed: the timeline is half
+// drained, ran dry, or playback ended.
+bool PLAYBACK_EDGE MorseConverter::advancePlayback() {
+    if (currentEvent) {
+#ifdef MORSE_JITTER_PROBE
+        recordEdge();
+#endif
+        playedLength.add(currentEvent);
+        playedUs += currentEventUs;
+    }
+
+    TimelineEvent event;
+    uint32_t markProgress;
+    if (!timeline.pop(event, markProgress)) {
+        currentEvent = 0;
+        currentEventUs = 0;
+        driveOutputs(false);
+        if (sourceDone) {
+            lastMessageUs = playedUs;
+            playbackState = PlaybackState::IDLE;
+            isPlaying = false;  // The playback task finishes up
+        } else {
+            starved = true;
+        }
+        return true;
+    }
+
+    // A speed change lands here, between events, so nothing in flight is cut short
+    if (timingPending) {
+        timing = pendingTiming;
+        timingPending = false;
+    }
+
+    const bool level = timelineEventLevel(event);
+    if (level) {
+        publishedProgress.store(markProgress, std::memory_order_release);
+    }
+    currentEvent = event;
+    currentEventUs = timelineEventDurationUs(timing, event);
+    playbackState = level ? PlaybackState::SYMBOL_ON : PlaybackState::SYMBOL_OFF;
+    driveOutputs(level);
+    nextDeadlineUs += currentEventUs;
+    return timeline.size() == MorseTimeline::CAPACITY / 2;
 }
 
 void MorseConverter::stopPlayback() {
+#ifdef MORSE_PLAYBACK_TIMER
+    portENTER_CRITICAL(&playbackMux);
+    if (timerReady) {
+        timer_set_alarm(PLAYBACK_TIMER_GROUP, PLAYBACK_TIMER_NUM, TIMER_ALARM_DIS);
+    }
     isPlaying = false;
-    currentMorse = nullptr;
+    portEXIT_CRITICAL(&playbackMux);
+#endif
+    finishPlayback();
+}
+
+// Playback task only, once the edge has stopped; hands the last slot back to the producer
+void MorseConverter::finishPlayback() {
+    isPlaying = false;
+    playbackOpen = false;
+    if (queuedMessage) {
+        messageQueue.pop();
+        queuedMessage = nullptr;
+    }
+    playingQueue = false;
+    packedSymbols = nullptr;
+    packedLength = 0;
+    textEncoder.reset();
     currentPosition = 0;
-    playbackState = PlaybackState::IDLE;
-    updateOutputs(false, hapticIntensity);
+    timeline.clear();
+    sourceDone = false;
+    starved = false;
+    if (timingPending) {
+        timing = pendingTiming;
+        timingPending = false;
+    }
+    if (currentEvent) {
+        lastMessageUs = playedUs;
+    }
+    currentEvent = 0;
+    currentEventUs = 0;
+    compiledProgress = {};
+    publishedProgress.store(compiledProgress.pack(), std::memory_order_release);
+    if (playbackState != PlaybackState::IDLE) {
+        playbackState = PlaybackState::IDLE;
+        updateOutputs(false, hapticIntensity);  // Unless the edge did as the last event ended
+    }
+}
+
+#ifdef MORSE_JITTER_PROBE
+void PLAYBACK_EDGE MorseConverter::recordEdge() {
+    const unsigned long now = micros();
+    idealEdgeUs += currentEventUs;
+
+    const long late = static_cast<long>(now - idealEdgeUs);
+    const uint32_t lateness = late > 0 ? late : 0;
+    const uint32_t intervalError = lateness > lastLatenessUs ? lateness - lastLatenessUs : lastLatenessUs - lateness;
+
+    jitterStats.edges++;
+    jitterStats.totalLatenessUs += lateness;
+    if (lateness > jitterStats.maxLatenessUs) {
+        jitterStats.maxLatenessUs = lateness;
+    }
+    if (intervalError > jitterStats.maxIntervalErrorUs) {
+        jitterStats.maxIntervalErrorUs = intervalError;
+    }
+    lastLatenessUs = lateness;
+}
+#endif
+
+uint32_t MorseConverter::getMessageDurationMs() const {
+    if (!isPlaying) {
+        return lastMessageUs / 1000;
+    }
+    return (playedUs + messageLength.remainingAfter(playedLength).durationUs(timing)) / 1000;
+}
+
+uint32_t MorseConverter::getRemainingMs() const {
+    return isPlaying ? messageLength.remainingAfter(playedLength).durationUs(timing) / 1000 : 0;
+}
+
+PlaybackProgress MorseConverter::getPlaybackProgress() const {
+    return PlaybackProgress::unpack(publishedProgress.load(std::memory_order_acquire));
+}
+
+const PlaybackJitterStats& MorseConverter::getJitterStats() const {
+#ifdef MORSE_JITTER_PROBE
+    return jitterStats;
+#else
+    static const PlaybackJitterStats empty = {};
+    return empty;
+#endif
 }
 
 bool MorseConverter::isPlaybackActive() const {
@@ -181,38 +778,25 @@ bool MorseConverter::isPlaybackActive() const {
 }
 
 void MorseConverter::indicateIdle() {
-    if (outputMode != OutputMode::VIBRATION_ONLY) {
-        setLED(false);  // Steady on
-    }
+    requestPattern(StatusPattern::IDLE);
 }
 
 void MorseConverter::indicateProcessing() {
-    if (outputMode != OutputMode::VIBRATION_ONLY) {
-        setLED(true);
-        delay(50);
-        setLED(false);
-    }
+    requestPattern(StatusPattern::PROCESSING);
 }
 
 void MorseConverter::indicatePlaying() {
-    if (outputMode != OutputMode::VIBRATION_ONLY) {
-        setLED(true);
-        delay(50);
-        setLED(false);
-    }
+    requestPattern(StatusPattern::PLAYING);
 }
 
 void MorseConverter::indicateError() {
-    if (outputMode != OutputMode::VIBRATION_ONLY) {
-        for (int i = 0; i < 3; i++) {
-            setLED(true);
-            delay(30);
-            setLED(false);
-            delay(30);
-        }
-    }
+    requestPattern(StatusPattern::ERROR);
+}
+
+void MorseConverter::indicateAdvertising() {
+    requestPattern(StatusPattern::ADVERTISING);
 }
 
 void MorseConverter::clearStatus() {
-    updateOutputs(false, hapticIntensity);
-} 
\ No newline at end of file
+    requestPattern(StatusPattern::OFF);
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "morse_decoder.h"
+
+void MorseDecoder::reset() {
+    node = 1;
+    invalid = false;
+    atWordStart = true;
+}
+
+size_t MorseDecoder::endLetter(char* out) {
+    if (node == 1 && !invalid) {
+        return 0;
+    }
+
+    const char c = invalid ? '\0' : MORSE_DECODE_TREE.node[node];
+    out[0] = c != '\0' ? c : MORSE_DECODE_UNKNOWN;
+    node = 1;
+    invalid = false;
+    atWordStart = false;
+    return 1;
+}
+
+size_t MorseDecoder::finishOutput(char* out, size_t written, size_t outSize) {
+    char decoded[1];
+    if (finish(decoded) > 0 && written + 1 < outSize) {
+        out[written++] = decoded[0];
+    }
+    // A trailing gap leaves a dangling space
+    if (written > 0 && out[written - 1] == ' ') {
+        written--;
+    }
+    out[written] = '\0';
+    return written;
+}
+
+size_t MorseDecoder::push(MorseSymbol symbol, char* out) {
+    switch (symbol) {
+        case MorseSymbol::DOT:
+        case MorseSymbol::DASH:
+            if (!invalid) {
+                node = 2 * node + (symbol == MorseSymbol::DASH ? 1 : 0);
+                if (node >= MORSE_DECODE_TREE_SIZE) {
+                    invalid = true;
+                }
+            }
+            return 0;
+
+        case MorseSymbol::LETTER_GAP:
+            if (node != 1 || invalid) {
+                return endLetter(out);
+            }
+            // No letter pending: a second gap in a row separates words
+            [[fallthrough]];
+        case MorseSymbol::WORD_GAP: {
+            size_t written = endLetter(out);
+            if (!atWordStart) {
+                out[written++] = ' ';
+                atWordStart = true;
+            }
+            return written;
+        }
+    }
+    return 0;
+}
+
+size_t MorseDecoder::push(char ascii, char* out) {
+    switch (ascii) {
+        case '.':
+            return push(MorseSymbol::DOT, out);
+        case '-':
+            return push(MorseSymbol::DASH, out);
+        case ' ':
+            return push(MorseSymbol::LETTER_GAP, out);
+        case '/':
+            return push(MorseSymbol::WORD_GAP, out);
+        default:
+            return 0;
+    }
+}
+
+size_t MorseDecoder::finish(char* out) {
+    const size_t written = endLetter(out);
+    reset();
+    return written;
+}
+
+size_t MorseDecoder::decode(const char* ascii, char* out, size_t outSize) {
+    if (outSize == 0) {
+        return 0;
+    }
+
+    reset();
+    size_t written = 0;
+    char decoded[2];
+    for (size_t i = 0; ascii[i] != '\0'; i++) {
+        const size_t count = push(ascii[i], decoded);
+        for (size_t j = 0; j < count && written + 1 < outSize; j++) {
+            out[written++] = decoded[j];
+        }
+    }
+
+    return finishOutput(out, written, outSize);
+}
+
+size_t MorseDecoder::decode(const PackedMorse& morse, char* out, size_t outSize) {
+    return decodePacked(morse.bytes(), morse.length(), out, outSize);
+}
+
+size_t MorseDecoder::decodePacked(const uint8_t* packed, size_t symbolCount, char* out, size_t outSize) {
+    if (outSize == 0) {
+        return 0;
+    }
+
+    reset();
+    size_t written = 0;
+    char decoded[2];
+    for (size_t i = 0; i < symbolCount; i++) {
+        const MorseSymbol symbol = static_cast<MorseSymbol>((packed[i >> 2] >> ((i & 3) * 2)) & 0x3);
+        const size_t count = push(symbol, decoded);
+        for (size_t j = 0; j < count && written + 1 < outSize; j++) {
+            out[written++] = decoded[j];
+        }
+    }
+
+    return finishOutput(out, written, outSize);
+}
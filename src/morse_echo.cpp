@@ -0,0 +1,182 @@
+#include "morse_echo.h"
+#include <string.h>
+
+static void writeHeader(EchoFormat format, bool truncated, size_t symbolCount, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(format);
+    out[1] = truncated ? ECHO_FLAG_TRUNCATED : 0;
+    out[2] = symbolCount & 0xFF;
+    out[3] = (symbolCount >> 8) & 0xFF;
+}
+
+static void writeCrc(uint32_t crc, uint8_t* out) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (crc >> (8 * i)) & 0xFF;
+    }
+}
+
+// Symbols past the end of the stream may be left over in the last byte
+static uint8_t lastByteMask(size_t symbolCount) {
+    const size_t used = symbolCount & 3;
+    return used ? static_cast<uint8_t>((1 << (used * 2)) - 1) : 0xFF;
+}
+
+size_t encodePackedEcho(const PackedMorse& morse, bool truncated, uint8_t* out, size_t outSize) {
+    const size_t symbols = morse.length();
+    const size_t size = packedEchoSize(symbols);
+    if (!out || outSize < size) {
+        return 0;
+    }
+
+    writeHeader(EchoFormat::PACKED, truncated, symbols, out);
+    const size_t dataSize = size - ECHO_HEADER_SIZE;
+    if (dataSize > 0) {
+        memcpy(out + ECHO_HEADER_SIZE, morse.bytes(), dataSize);
+        out[size - 1] &= lastByteMask(symbols);
+    }
+    return size;
+}
+
+size_t encodeDigestEcho(const PackedMorse& morse, bool truncated, uint8_t* out, size_t outSize) {
+    if (!out || outSize < ECHO_DIGEST_SIZE) {
+        return 0;
+    }
+
+    writeHeader(EchoFormat::DIGEST, truncated, morse.length(), out);
+    writeCrc(packedMorseCrc32(morse), out + ECHO_HEADER_SIZE);
+    return ECHO_DIGEST_SIZE;
+}
+
+size_t encodeCachedEcho(bool streamed, bool truncated, size_t symbolCount, uint32_t crc, uint8_t* out, size_t outSize) {
+    if (!out || outSize < ECHO_DIGEST_SIZE) {
+        return 0;
+    }
+
+    // The end marker has the DIGEST echo's layout, with sequence 0 in place of the format
+    writeHeader(EchoFormat::DIGEST, truncated, symbolCount, out);
+    if (streamed) {
+        out[0] = ECHO_CHUNK_END;
+    }
+    out[1] |= ECHO_FLAG_CACHED;
+    writeCrc(crc, out + ECHO_HEADER_SIZE);
+    return ECHO_DIGEST_SIZE;
+}
+
+// CRC-32 (IEEE, reflected), bitwise: echoes are at most a few hundred bytes
+static uint32_t crc32Update(uint32_t crc, uint8_t byte) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return crc;
+}
+
+uint32_t packedMorseCrc32(const PackedMorse& morse) {
+    return packedMorseCrc32(morse.bytes(), morse.length());
+}
+
+uint32_t packedMorseCrc32(const uint8_t* bytes, size_t symbols) {
+    const size_t size = (symbols + 3) / 4;
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc = crc32Update(crc, i + 1 == size ? bytes[i] & lastByteMask(symbols) : bytes[i]);
+    }
+    return ~crc;
+}
+
+void EchoStreamer::begin(EchoFormat echoFormat, size_t size, EchoChunkSink chunkSink, void* sinkContext) {
+    format = echoFormat;
+    chunkSize = size < ECHO_MIN_CHUNK ? ECHO_MIN_CHUNK : (size > ECHO_MAX_CHUNK ? ECHO_MAX_CHUNK : size);
+    sink = chunkSink;
+    context = sinkContext;
+    failed = false;
+    sequence = 0;
+    fill = 1;  // Room for the chunk header
+    symbolCount = 0;
+    crc = 0xFFFFFFFF;
+    packedByte = 0;
+}
+
+void EchoStreamer::flush() {
+    if (fill <= 1) {
+        return;
+    }
+    chunk[0] = sequence;
+    sequence = (sequence + 1) & 0x7F;
+    if (!failed && !sink(chunk, fill, context)) {
+        failed = true;
+    }
+    fill = 1;
+}
+
+void EchoStreamer::put(uint8_t byte) {
+    if (format == EchoFormat::DIGEST) {
+        return;
+    }
+    chunk[fill++] = byte;
+    if (fill == chunkSize) {
+        flush();
+    }
+}
+
+void EchoStreamer::addPackedByte(uint8_t byte) {
+    crc = crc32Update(crc, byte);
+    if (format == EchoFormat::PACKED) {
+        put(byte);
+    }
+}
+
+void EchoStreamer::add(MorseSymbol symbol) {
+    const uint8_t shift = (symbolCount & 3) * 2;
+    packedByte |= static_cast<uint8_t>(symbol) << shift;
+    symbolCount++;
+    if ((symbolCount & 3) == 0) {
+        addPackedByte(packedByte);
+        packedByte = 0;
+    }
+
+    if (format == EchoFormat::ASCII) {
+        switch (symbol) {
+            case MorseSymbol::DOT:
+                put('.');
+                break;
+            case MorseSymbol::DASH:
+                put('-');
+                break;
+            case MorseSymbol::WORD_GAP:
+                put(' ');
+                put(' ');
+                break;
+            case MorseSymbol::LETTER_GAP:
+                put(' ');
+                break;
+        }
+    }
+}
+
+bool EchoStreamer::finish(bool truncated) {
+    if (symbolCount & 3) {
+        addPackedByte(packedByte);
+        packedByte = 0;
+    }
+    flush();
+
+    const uint32_t digest = ~crc;
+    uint8_t end[ECHO_END_SIZE] = {
+        static_cast<uint8_t>(ECHO_CHUNK_END | sequence),
+        static_cast<uint8_t>(truncated ? ECHO_FLAG_TRUNCATED : 0),
+        static_cast<uint8_t>(symbolCount & 0xFF),
+        static_cast<uint8_t>((symbolCount >> 8) & 0xFF),
+    };
+    for (int i = 0; i < 4; i++) {
+        end[4 + i] = (digest >> (8 * i)) & 0xFF;
+    }
+    if (!failed && !sink(end, sizeof(end), context)) {
+        failed = true;
+    }
+    return !failed;
+}
+
+uint32_t EchoStreamer::symbols() const {
+    return symbolCount;
+}
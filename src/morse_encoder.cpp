@@ -0,0 +1,309 @@
+#include "morse_encoder.h"
+#include <string.h>
+
+// MORSE_GLYPHS and its page tables, generated from alphabets/*.csv
+#include "morse_unicode_tables.h"
+
+size_t decodeUtf8(const char* text, size_t length, uint32_t& codePoint) {
+    const uint8_t lead = static_cast<uint8_t>(text[0]);
+    codePoint = UTF8_INVALID;
+    if (lead < 0x80) {
+        codePoint = lead;
+        return 1;
+    }
+
+    size_t count;
+    uint32_t value;
+    uint32_t minimum;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        count = 2;
+        value = lead & 0x1F;
+        minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        count = 3;
+        value = lead & 0x0F;
+        minimum = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        count = 4;
+        value = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        return 1;  // Continuation byte or invalid lead
+    }
+    if (count > length) {
+        return 1;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        const uint8_t byte = static_cast<uint8_t>(text[i]);
+        if ((byte & 0xC0) != 0x80) {
+            return 1;
+        }
+        value = value << 6 | (byte & 0x3F);
+    }
+    // Overlong forms, UTF-16 surrogates and values past U+10FFFF
+    if (value < minimum || (value >= 0xD800 && value <= 0xDFFF) || value > 0x10FFFF) {
+        return 1;
+    }
+    codePoint = value;
+    return count;
+}
+
+// Two table loads whatever the code point: page, then glyph
+const MorseGlyphEntry* morseGlyphFor(uint32_t codePoint, MorseAlphabet alphabet) {
+    if (codePoint > 0xFFFF) {
+        return nullptr;
+    }
+    const uint8_t page = MORSE_UNICODE_PAGE_INDEX.entry[codePoint >> 8];
+    if (page == MORSE_UNMAPPED) {
+        return nullptr;
+    }
+    const uint8_t index = MORSE_UNICODE_PAGES[page].entry[codePoint & 0xFF];
+    if (index == MORSE_UNMAPPED || MORSE_GLYPHS[index].alphabet != alphabet) {
+        return nullptr;
+    }
+    return &MORSE_GLYPHS[index];
+}
+
+// ASCII length of a non-ASCII character's letters, including the space between two
+static size_t glyphLength(const MorseGlyphEntry* glyph) {
+    if (!glyph) {
+        return 0;
+    }
+    const size_t second = glyph->letters[1].length;
+    return glyph->letters[0].length + (second > 0 ? second + 1 : 0);
+}
+
+static char* writeCode(char* cursor, PackedCode code) {
+    for (uint8_t j = 0; j < code.length; j++) {
+        *cursor++ = (code.bits >> j) & 1 ? '-' : '.';
+    }
+    return cursor;
+}
+
+size_t morseEncodedLength(const char* text, MorseAlphabet alphabet) {
+    size_t length = 0;
+
+    for (size_t i = 0; text[i] != '\0';) {
+        if (i > 0) {
+            length++;
+        }
+        if (static_cast<uint8_t>(text[i]) < 0x80) {
+            length += packedCodeFor(text[i++]).length;
+            continue;
+        }
+        uint32_t codePoint;
+        const size_t used = decodeUtf8(text + i, SIZE_MAX, codePoint);
+        length += glyphLength(morseGlyphFor(codePoint, alphabet));
+        i += used;
+    }
+    return length;
+}
+
+// encodeMorse from the first non-ASCII byte at text[i] on; returns the new cursor
+static char* encodeMorseUtf8(const char* text, size_t i, char* cursor, char* const end, MorseAlphabet alphabet,
+                             bool& truncated) {
+    while (text[i] != '\0') {
+        const char* code = nullptr;
+        const MorseGlyphEntry* glyph = nullptr;
+        size_t codeLength;
+        size_t used = 1;
+        if (static_cast<uint8_t>(text[i]) < 0x80) {
+            code = morseCodeFor(text[i]);
+            codeLength = packedCodeFor(text[i]).length;
+        } else {
+            uint32_t codePoint;
+            used = decodeUtf8(text + i, SIZE_MAX, codePoint);
+            glyph = morseGlyphFor(codePoint, alphabet);
+            codeLength = glyphLength(glyph);
+        }
+        const size_t needed = codeLength + (i > 0 ? 1 : 0);
+
+        if (needed > (size_t)(end - cursor)) {
+            truncated = true;
+            break;
+        }
+        if (i > 0) {
+            *cursor++ = ' ';
+        }
+        if (glyph) {
+            cursor = writeCode(cursor, glyph->letters[0]);
+            if (glyph->letters[1].length > 0) {
+                *cursor++ = ' ';
+                cursor = writeCode(cursor, glyph->letters[1]);
+            }
+        } else {
+            for (size_t j = 0; j < codeLength; j++) {
+                *cursor++ = code[j];
+            }
+        }
+        i += used;
+    }
+    return cursor;
+}
+
+MorseEncodeResult encodeMorse(const char* text, char* out, size_t outSize, MorseAlphabet alphabet) {
+    MorseEncodeResult result = {0, false};
+    if (outSize == 0) {
+        result.truncated = text[0] != '\0';
+        return result;
+    }
+
+    char* cursor = out;
+    char* const end = out + outSize - 1;  // Reserve the terminator
+
+    // ASCII fast path, one table lookup per byte. As a signed byte, the terminator and
+    // every byte from 0x80 up are <= 0, so one compare ends the run for either.
+    size_t i = 0;
+    for (; static_cast<int8_t>(text[i]) > 0; i++) {
+        const char* code = morseCodeFor(text[i]);
+        const size_t codeLength = packedCodeFor(text[i]).length;
+        const size_t needed = codeLength + (i > 0 ? 1 : 0);
+
+        if (needed > (size_t)(end - cursor)) {
+            result.truncated = true;
+            break;
+        }
+        if (i > 0) {
+            *cursor++ = ' ';
+        }
+        for (size_t j = 0; j < codeLength; j++) {
+            *cursor++ = code[j];
+        }
+    }
+    if (!result.truncated && text[i] != '\0') {
+        cursor = encodeMorseUtf8(text, i, cursor, end, alphabet, result.truncated);
+    }
+
+    *cursor = '\0';
+    result.length = cursor - out;
+    return result;
+}
+
+void MorseStreamEncoder::begin(const char* text, MorseAlphabet alphabet) {
+    begin(text, text ? strlen(text) : 0, alphabet);
+}
+
+void MorseStreamEncoder::begin(const char* text, size_t length, MorseAlphabet alphabet) {
+    this->text = text;
+    this->alphabet = alphabet;
+    textLength = text ? length : 0;
+    position = 0;
+    letterStart = 0;
+    code = {0, 0};
+    secondLetter = {0, 0};
+    symbolIndex = 0;
+    started = false;
+}
+
+void MorseStreamEncoder::reset() {
+    begin(nullptr, 0);
+}
+
+// ASCII fast path: the same loop as the byte-at-a-time encoder, with no calls but
+// the tail call into nextLetterUtf8(). A signed byte <= 0 (NUL, or UTF-8 from 0x80
+// up) leaves it, and so does the rest of a two-letter character, whose bytes stay
+// unconsumed until its second letter is sent.
+bool MorseStreamEncoder::next(MorseSymbol& symbol) {
+    if (symbolIndex < code.length) {
+        symbol = (code.bits >> symbolIndex++) & 1 ? MorseSymbol::DASH : MorseSymbol::DOT;
+        return true;
+    }
+
+    // Advance to the next mapped character, remembering whether a space was crossed
+    bool crossedSpace = false;
+    while (position < textLength) {
+        const char c = text[position];
+        if (static_cast<int8_t>(c) <= 0) {
+            return nextLetterUtf8(symbol, crossedSpace);
+        }
+        position++;
+        if (c == ' ') {
+            crossedSpace = true;
+            continue;
+        }
+        const PackedCode nextCode = packedCodeFor(c);
+        if (nextCode.length == 0) {
+            continue;
+        }
+        letterStart = position - 1;
+        code = nextCode;
+        if (started) {
+            symbolIndex = 0;
+            symbol = crossedSpace ? MorseSymbol::WORD_GAP : MorseSymbol::LETTER_GAP;
+            return true;
+        }
+        started = true;
+        symbolIndex = 1;
+        symbol = code.bits & 1 ? MorseSymbol::DASH : MorseSymbol::DOT;
+        return true;
+    }
+    return false;
+}
+
+// Moves on to a letter whose character starts at byte start
+bool MorseStreamEncoder::startLetter(PackedCode nextCode, size_t start, bool crossedSpace, MorseSymbol& symbol) {
+    letterStart = start;
+    code = nextCode;
+    if (started) {
+        symbolIndex = 0;
+        symbol = crossedSpace ? MorseSymbol::WORD_GAP : MorseSymbol::LETTER_GAP;
+        return true;
+    }
+    started = true;
+    symbolIndex = 1;
+    symbol = code.bits & 1 ? MorseSymbol::DASH : MorseSymbol::DOT;
+    return true;
+}
+
+bool MorseStreamEncoder::nextLetterUtf8(MorseSymbol& symbol, bool crossedSpace) {
+    if (secondLetter.length > 0) {
+        // Second letter of the character at position; now it is consumed
+        uint32_t codePoint;
+        position += decodeUtf8(text + position, textLength - position, codePoint);
+        code = secondLetter;
+        secondLetter = {0, 0};
+        symbolIndex = 0;
+        symbol = MorseSymbol::LETTER_GAP;
+        return true;
+    }
+
+    while (position < textLength) {
+        const size_t start = position;
+        const char c = text[position];
+        if (c == ' ') {
+            position++;
+            crossedSpace = true;
+            continue;
+        }
+
+        PackedCode nextCode = {0, 0};
+        if (static_cast<uint8_t>(c) < 0x80) {
+            position++;
+            nextCode = packedCodeFor(c);
+        } else {
+            uint32_t codePoint;
+            position += decodeUtf8(text + start, textLength - start, codePoint);
+            const MorseGlyphEntry* glyph = morseGlyphFor(codePoint, alphabet);
+            if (glyph) {
+                nextCode = glyph->letters[0];
+                secondLetter = glyph->letters[1];
+                if (secondLetter.length > 0) {
+                    position = start;  // Sends the fast path back here for the second letter
+                }
+            }
+        }
+        if (nextCode.length > 0) {
+            return startLetter(nextCode, start, crossedSpace, symbol);
+        }
+    }
+    return false;
+}
+
+size_t MorseStreamEncoder::textPosition() const {
+    return position;
+}
+
+size_t MorseStreamEncoder::letterPosition() const {
+    return letterStart;
+}
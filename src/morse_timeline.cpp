@@ -0,0 +1,141 @@
+#include "morse_timeline.h"
+#include <esp_attr.h>
+
+MorseTiming makeMorseTiming(uint8_t wpm, uint8_t farnsworthWpm) {
+    wpm = wpm < MIN_WPM ? MIN_WPM : (wpm > MAX_WPM ? MAX_WPM : wpm);
+    if (farnsworthWpm == 0 || farnsworthWpm > wpm) {
+        farnsworthWpm = wpm;
+    } else if (farnsworthWpm < MIN_WPM) {
+        farnsworthWpm = MIN_WPM;
+    }
+
+    MorseTiming timing;
+    timing.wpm = wpm;
+    timing.farnsworthWpm = farnsworthWpm;
+    timing.dotUs = 1200000UL / wpm;
+
+    // ARRL Farnsworth formula: the 19 units of gap in PARIS share the time left over
+    // once its 31 units of letters are sent at wpm. Equal speeds give 3 and 7 dots.
+    const uint64_t gapsUs = (60000000ULL * wpm - 37200000ULL * farnsworthWpm) / (uint64_t(wpm) * farnsworthWpm);
+    timing.letterGapUs = static_cast<uint32_t>(gapsUs * LETTER_GAP_UNITS / 19);
+    timing.wordGapUs = static_cast<uint32_t>(gapsUs * WORD_GAP_UNITS / 19);
+    return timing;
+}
+
+// IRAM: called from the playback edge, which may run while flash is busy
+uint32_t IRAM_ATTR timelineEventDurationUs(const MorseTiming& timing, TimelineEvent event) {
+    if (isLetterGapEvent(event)) {
+        return timing.letterGapUs;
+    }
+    if (isWordGapEvent(event)) {
+        return timing.wordGapUs;
+    }
+    return timelineEventUnits(event) * timing.dotUs;
+}
+
+void IRAM_ATTR TimelineLength::add(TimelineEvent event) {
+    if (isLetterGapEvent(event)) {
+        letterGaps++;
+    } else if (isWordGapEvent(event)) {
+        wordGaps++;
+    } else {
+        elementUnits += timelineEventUnits(event);
+    }
+}
+
+void TimelineLength::add(const TimelineLength& other) {
+    elementUnits += other.elementUnits;
+    letterGaps += other.letterGaps;
+    wordGaps += other.wordGaps;
+}
+
+bool TimelineLength::isEmpty() const {
+    return elementUnits == 0 && letterGaps == 0 && wordGaps == 0;
+}
+
+uint64_t TimelineLength::durationUs(const MorseTiming& timing) const {
+    return static_cast<uint64_t>(elementUnits) * timing.dotUs
+           + static_cast<uint64_t>(letterGaps) * timing.letterGapUs
+           + static_cast<uint64_t>(wordGaps) * timing.wordGapUs;
+}
+
+TimelineLength TimelineLength::remainingAfter(const TimelineLength& played) const {
+    TimelineLength remaining;
+    remaining.elementUnits = elementUnits - played.elementUnits;
+    remaining.letterGaps = letterGaps - played.letterGaps;
+    remaining.wordGaps = wordGaps - played.wordGaps;
+    return remaining;
+}
+
+void TimelineCompiler::reset() {
+    pendingGap = 0;
+    afterMark = false;
+}
+
+uint8_t TimelineCompiler::compile(MorseSymbol symbol, TimelineEvent* events) {
+    switch (symbol) {
+        case MorseSymbol::DOT:
+        case MorseSymbol::DASH: {
+            uint8_t written = 0;
+            if (afterMark) {
+                events[written++] = makeTimelineEvent(false, pendingGap);
+            }
+            events[written++] = makeTimelineEvent(true, symbol == MorseSymbol::DOT ? DOT_UNITS : DASH_UNITS);
+            afterMark = true;
+            pendingGap = SYMBOL_GAP_UNITS;
+            return written;
+        }
+
+        case MorseSymbol::LETTER_GAP:
+            if (pendingGap < LETTER_GAP_UNITS) {
+                pendingGap = LETTER_GAP_UNITS;
+            }
+            return 0;
+
+        case MorseSymbol::WORD_GAP:
+            pendingGap = WORD_GAP_UNITS;
+            return 0;
+    }
+    return 0;
+}
+
+void MorseTimeline::clear() {
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    compiler.reset();
+}
+
+bool MorseTimeline::hasRoom() const {
+    return size() + 2 <= CAPACITY;
+}
+
+bool MorseTimeline::isEmpty() const {
+    return size() == 0;
+}
+
+uint16_t MorseTimeline::size() const {
+    return static_cast<uint16_t>(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+}
+
+void MorseTimeline::push(MorseSymbol symbol, uint32_t markProgress) {
+    TimelineEvent compiled[2];
+    const uint8_t written = compiler.compile(symbol, compiled);
+    uint16_t back = tail.load(std::memory_order_relaxed);
+    for (uint8_t i = 0; i < written; i++) {
+        events[back % CAPACITY] = compiled[i];
+        marks[back % CAPACITY] = markProgress;
+        back++;
+    }
+    tail.store(back, std::memory_order_release);
+}
+
+bool IRAM_ATTR MorseTimeline::pop(TimelineEvent& event, uint32_t& markProgress) {
+    const uint16_t front = head.load(std::memory_order_relaxed);
+    if (front == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = events[front % CAPACITY];
+    markProgress = marks[front % CAPACITY];
+    head.store(front + 1, std::memory_order_release);
+    return true;
+}
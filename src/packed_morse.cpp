@@ -0,0 +1,132 @@
+#include "packed_morse.h"
+#include <string.h>
+
+void PackedMorse::clear() {
+    count = 0;
+}
+
+bool PackedMorse::append(MorseSymbol symbol) {
+    if (count >= CAPACITY) {
+        return false;
+    }
+
+    const size_t byte = count >> 2;
+    const uint8_t shift = (count & 3) * 2;
+    data[byte] = (data[byte] & ~(0x3 << shift)) | (static_cast<uint8_t>(symbol) << shift);
+    count++;
+    return true;
+}
+
+bool PackedMorse::appendCode(PackedCode code) {
+    if (count + code.length > CAPACITY) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < code.length; i++) {
+        append((code.bits >> i) & 1 ? MorseSymbol::DASH : MorseSymbol::DOT);
+    }
+    return true;
+}
+
+void PackedMorse::setLast(MorseSymbol symbol) {
+    if (count == 0) {
+        return;
+    }
+    count--;
+    append(symbol);
+}
+
+void PackedMorse::truncate(size_t length) {
+    if (length < count) {
+        count = length;
+    }
+}
+
+bool PackedMorse::assign(const uint8_t* bytes, size_t symbolCount) {
+    if (symbolCount > CAPACITY) {
+        return false;
+    }
+    memcpy(data, bytes, (symbolCount + 3) / 4);
+    count = symbolCount;
+    return true;
+}
+
+MorseSymbol PackedMorse::at(size_t index) const {
+    return packedSymbolAt(data, index);
+}
+
+const uint8_t* PackedMorse::bytes() const {
+    return data;
+}
+
+size_t PackedMorse::length() const {
+    return count;
+}
+
+bool PackedMorse::isEmpty() const {
+    return count == 0;
+}
+
+bool PackedMorse::fromAscii(const char* morse) {
+    clear();
+
+    for (int i = 0; morse[i] != '\0'; i++) {
+        MorseSymbol symbol;
+        switch (morse[i]) {
+            case '.':
+                symbol = MorseSymbol::DOT;
+                break;
+            case '-':
+                symbol = MorseSymbol::DASH;
+                break;
+            case ' ':
+                if (count > 0 && at(count - 1) == MorseSymbol::LETTER_GAP) {
+                    setLast(MorseSymbol::WORD_GAP);
+                    continue;
+                }
+                if (count > 0 && at(count - 1) == MorseSymbol::WORD_GAP) {
+                    continue;
+                }
+                symbol = MorseSymbol::LETTER_GAP;
+                break;
+            default:
+                continue;
+        }
+        if (!append(symbol)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t PackedMorse::toAscii(char* out, size_t outSize) const {
+    if (outSize == 0) {
+        return 0;
+    }
+
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        const MorseSymbol symbol = at(i);
+        const size_t width = symbol == MorseSymbol::WORD_GAP ? 2 : 1;
+        if (written + width >= outSize) {
+            break;
+        }
+        switch (symbol) {
+            case MorseSymbol::DOT:
+                out[written++] = '.';
+                break;
+            case MorseSymbol::DASH:
+                out[written++] = '-';
+                break;
+            case MorseSymbol::LETTER_GAP:
+                out[written++] = ' ';
+                break;
+            case MorseSymbol::WORD_GAP:
+                out[written++] = ' ';
+                out[written++] = ' ';
+                break;
+        }
+    }
+    out[written] = '\0';
+    return written;
+}
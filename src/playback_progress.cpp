@@ -0,0 +1,41 @@
+#include "playback_progress.h"
+
+// symbol << 24 | message << 16 | character; no letter is long enough for a symbol
+// byte of 0xFF, so that marks idle
+static const uint32_t PROGRESS_IDLE = 0xFF000000u;
+
+uint32_t PlaybackProgress::pack() const {
+    if (!playing) {
+        return PROGRESS_IDLE;
+    }
+    return static_cast<uint32_t>(symbol) << 24 | static_cast<uint32_t>(message) << 16 | character;
+}
+
+PlaybackProgress PlaybackProgress::unpack(uint32_t packed) {
+    if ((packed & PROGRESS_IDLE) == PROGRESS_IDLE) {
+        return {false, 0, 0, 0};
+    }
+    return {true, static_cast<uint8_t>(packed >> 16), static_cast<uint16_t>(packed), static_cast<uint8_t>(packed >> 24)};
+}
+
+void ProgressThrottle::reset() {
+    sent = {};
+    sentMs = 0;
+}
+
+bool ProgressThrottle::shouldSend(const PlaybackProgress& progress, uint32_t nowMs) {
+    if (progress.playing == sent.playing && progress.message == sent.message
+        && progress.character == sent.character && progress.symbol == sent.symbol) {
+        return false;
+    }
+
+    const bool sameLetter = progress.playing && sent.playing && progress.message == sent.message
+                            && progress.character == sent.character;
+    if (sameLetter && nowMs - sentMs < PROGRESS_MIN_INTERVAL_MS) {
+        return false;  // Picked up by a later sample once the interval has passed
+    }
+
+    sent = progress;
+    sentMs = nowMs;
+    return true;
+}
@@ -0,0 +1,118 @@
+#include "preset_store.h"
+#include <string.h>
+
+static void writeU16(uint16_t value, uint8_t* out) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+static uint16_t readU16(const uint8_t* data) {
+    return data[0] | data[1] << 8;
+}
+
+PresetStatus PresetStore::store(uint16_t id, const PackedMorse& morse, size_t& slot) {
+    if (morse.isEmpty()) {
+        return PresetStatus::EMPTY;
+    }
+    if (morse.length() > MAX_SYMBOLS) {
+        return PresetStatus::TOO_LARGE;
+    }
+
+    // The preset being replaced keeps its slot; otherwise the first free one
+    const MorsePreset* existing = find(id);
+    MorsePreset* target = existing ? &slots[existing - slots] : nullptr;
+    for (size_t i = 0; !target && i < CAPACITY; i++) {
+        if (slots[i].symbolCount == 0) {
+            target = &slots[i];
+        }
+    }
+    if (!target) {
+        return PresetStatus::FULL;
+    }
+
+    target->id = id;
+    target->symbolCount = morse.length();
+    memcpy(target->packed, morse.bytes(), (morse.length() + 3) / 4);
+    slot = target - slots;
+    return PresetStatus::OK;
+}
+
+PresetStatus PresetStore::remove(uint16_t id, size_t& slot) {
+    const MorsePreset* preset = find(id);
+    if (!preset) {
+        return PresetStatus::NOT_FOUND;
+    }
+    slot = preset - slots;
+    slots[slot].symbolCount = 0;
+    return PresetStatus::OK;
+}
+
+const MorsePreset* PresetStore::find(uint16_t id) const {
+    for (const MorsePreset& preset : slots) {
+        if (preset.symbolCount != 0 && preset.id == id) {
+            return &preset;
+        }
+    }
+    return nullptr;
+}
+
+size_t PresetStore::size() const {
+    size_t count = 0;
+    for (const MorsePreset& preset : slots) {
+        count += preset.symbolCount != 0;
+    }
+    return count;
+}
+
+size_t PresetStore::saveSlot(size_t slot, uint8_t* out, size_t outSize) const {
+    if (slot >= CAPACITY || slots[slot].symbolCount == 0) {
+        return 0;
+    }
+    const MorsePreset& preset = slots[slot];
+    const size_t size = presetImageSize(preset.symbolCount);
+    if (!out || outSize < size) {
+        return 0;
+    }
+
+    writeU16(preset.id, out);
+    writeU16(preset.symbolCount, out + 2);
+    memcpy(out + PRESET_IMAGE_HEADER_SIZE, preset.packed, size - PRESET_IMAGE_HEADER_SIZE);
+    return size;
+}
+
+bool PresetStore::loadSlot(size_t slot, const uint8_t* data, size_t length) {
+    if (slot >= CAPACITY || !data || length < PRESET_IMAGE_HEADER_SIZE) {
+        return false;
+    }
+    const uint16_t symbolCount = readU16(data + 2);
+    if (symbolCount == 0 || symbolCount > MAX_SYMBOLS || length != presetImageSize(symbolCount)) {
+        return false;
+    }
+
+    MorsePreset& preset = slots[slot];
+    preset.id = readU16(data);
+    preset.symbolCount = symbolCount;
+    memcpy(preset.packed, data + PRESET_IMAGE_HEADER_SIZE, length - PRESET_IMAGE_HEADER_SIZE);
+    return true;
+}
+
+size_t PresetStore::list(uint8_t* out, size_t outSize) const {
+    const size_t count = size();
+    const size_t length = PRESET_LIST_HEADER_SIZE + count * PRESET_LIST_ENTRY_SIZE;
+    if (!out || outSize < length) {
+        return 0;
+    }
+
+    out[0] = PRESET_LIST;
+    out[1] = static_cast<uint8_t>(PresetStatus::OK);
+    out[2] = count;
+    uint8_t* entry = out + PRESET_LIST_HEADER_SIZE;
+    for (const MorsePreset& preset : slots) {
+        if (preset.symbolCount != 0) {
+            writeU16(preset.id, entry);
+            writeU16(preset.symbolCount, entry + 2);
+            entry += PRESET_LIST_ENTRY_SIZE;
+        }
+    }
+    return length;
+}
@@ -0,0 +1,103 @@
+#include "status_pattern.h"
+
+namespace {
+
+const uint8_t BOTH = PATTERN_LED | PATTERN_HAPTIC;
+
+const PatternStep OFF_STEPS[] = {{BOTH, false, 0}};
+const PatternStep IDLE_STEPS[] = {{PATTERN_LED, false, 0}};
+const PatternStep STARTUP_STEPS[] = {
+    {PATTERN_LED, true, 100}, {PATTERN_LED, false, 100},
+    {PATTERN_LED, true, 100}, {PATTERN_LED, false, 100},
+    {PATTERN_LED, true, 100}, {PATTERN_LED, false, 100},
+};
+const PatternStep BLINK_STEPS[] = {{PATTERN_LED, true, 50}, {PATTERN_LED, false, 0}};
+const PatternStep ERROR_STEPS[] = {
+    {PATTERN_LED, true, 30}, {PATTERN_LED, false, 30},
+    {PATTERN_LED, true, 30}, {PATTERN_LED, false, 30},
+    {PATTERN_LED, true, 30}, {PATTERN_LED, false, 30},
+};
+const PatternStep ADVERTISING_STEPS[] = {{PATTERN_LED, true, 500}, {PATTERN_LED, false, 500}};
+const PatternStep HAPTIC_PREVIEW_STEPS[] = {{PATTERN_HAPTIC, true, 300}, {PATTERN_HAPTIC, false, 0}};
+
+struct PatternEntry {
+    const PatternStep* steps;
+    uint8_t count;
+    bool repeat;
+};
+
+#define PATTERN(steps, repeat) {steps, sizeof(steps) / sizeof(steps[0]), repeat}
+
+// Indexed by StatusPattern
+const PatternEntry PATTERN_TABLE[] = {
+    {nullptr, 0, false},                  // NONE
+    PATTERN(OFF_STEPS, false),
+    PATTERN(IDLE_STEPS, false),
+    PATTERN(STARTUP_STEPS, false),
+    PATTERN(BLINK_STEPS, false),          // PROCESSING
+    PATTERN(BLINK_STEPS, false),          // PLAYING
+    PATTERN(ERROR_STEPS, false),
+    PATTERN(ADVERTISING_STEPS, true),
+    PATTERN(HAPTIC_PREVIEW_STEPS, false),
+};
+
+#undef PATTERN
+
+} // namespace
+
+void StatusSequencer::start(StatusPattern next, unsigned long nowMs) {
+    const PatternEntry& entry = PATTERN_TABLE[static_cast<uint8_t>(next)];
+    if (!entry.steps || (entry.repeat && next == pattern && isActive())) {
+        return;
+    }
+    pattern = next;
+    steps = entry.steps;
+    stepCount = entry.count;
+    stepIndex = 0;
+    repeat = entry.repeat;
+    stepPending = true;
+    stepStartMs = nowMs;
+}
+
+void StatusSequencer::cancel() {
+    steps = nullptr;
+    stepPending = false;
+    pattern = StatusPattern::NONE;
+}
+
+bool StatusSequencer::isActive() const {
+    return steps != nullptr;
+}
+
+bool StatusSequencer::update(unsigned long nowMs, PatternStep& step) {
+    if (!steps) {
+        return false;
+    }
+
+    if (!stepPending) {
+        if (nowMs - stepStartMs < steps[stepIndex].durationMs) {
+            return false;
+        }
+        stepStartMs += steps[stepIndex].durationMs;
+        if (++stepIndex == stepCount) {
+            if (!repeat) {
+                cancel();
+                return false;
+            }
+            stepIndex = 0;
+        }
+    }
+
+    stepPending = false;
+    step = steps[stepIndex];
+    return true;
+}
+
+uint32_t StatusSequencer::msUntilNextStep(unsigned long nowMs) const {
+    if (!steps || stepPending) {
+        return 0;
+    }
+    const unsigned long elapsed = nowMs - stepStartMs;
+    const uint16_t duration = steps[stepIndex].durationMs;
+    return elapsed >= duration ? 0 : duration - elapsed;
+}
@@ -1,8 +1,9 @@
 import csv
 
 def load_morse_alphabet() -> dict:
-    with open("morse_alphabet.csv", "r") as file:
-        reader = csv.reader(file)
+    with open("morse_alphabet.csv", "r", newline="") as file:
+        reader = csv.reader(file, skipinitialspace=True)
+        next(reader)  # Header
         return {row[0]: row[1] for row in reader}
 
 def text_to_morse(text: str, should_print = False) -> str: